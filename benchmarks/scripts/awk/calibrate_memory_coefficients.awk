@@ -0,0 +1,117 @@
+# Computes the Constants::Memory coefficients from the output of a MEMORY_BENCHMARK build (MemoryOccupancy.txt).
+# Every vertex takes six rows: clusters per layer, tracklets capacity, tracklets, cells capacity, cells and roads.
+# Usage: awk -v quantile=0.95 -f calibrate_memory_coefficients.awk MemoryOccupancy.txt
+function sortSamples(samples, samplesNum,    iSample, jSample, currentSample) {
+
+  for(iSample = 2; iSample <= samplesNum; iSample++) {
+
+    currentSample = samples[iSample];
+
+    for(jSample = iSample - 1; jSample >= 1 && samples[jSample] > currentSample; jSample--) {
+
+      samples[jSample + 1] = samples[jSample];
+    }
+
+    samples[jSample + 1] = currentSample;
+  }
+}
+function computeQuantile(samples, samplesNum,    quantileIndex) {
+
+  if(samplesNum == 0) {
+
+    return 0;
+  }
+
+  sortSamples(samples, samplesNum);
+  quantileIndex = int(quantile * samplesNum);
+
+  if(quantileIndex < quantile * samplesNum) {
+
+    quantileIndex++;
+  }
+
+  if(quantileIndex < 1) {
+
+    quantileIndex = 1;
+  }
+
+  return samples[quantileIndex];
+}
+BEGIN {
+  if(quantile == "") {
+
+    quantile = 0.95;
+  }
+
+  rowsCount = 0;
+}
+{
+  rowType = rowsCount % 6;
+  rowsCount++;
+
+  if(rowType == 0) {
+
+    for(iLayer = 1; iLayer <= NF; iLayer++) {
+
+      clusters[iLayer] = $iLayer;
+    }
+
+  } else if(rowType == 2) {
+
+    for(iLayer = 1; iLayer <= NF; iLayer++) {
+
+      if(clusters[iLayer] * clusters[iLayer + 1] > 0) {
+
+        trackletsSamples[iLayer, ++trackletsSamplesNum[iLayer]] = $iLayer / (clusters[iLayer] * clusters[iLayer + 1]);
+      }
+    }
+
+    trackletsLayersNum = NF;
+
+  } else if(rowType == 4) {
+
+    for(iLayer = 1; iLayer <= NF; iLayer++) {
+
+      if(clusters[iLayer] * clusters[iLayer + 1] * clusters[iLayer + 2] > 0) {
+
+        cellsSamples[iLayer, ++cellsSamplesNum[iLayer]] = $iLayer / (clusters[iLayer] * clusters[iLayer + 1] * clusters[iLayer + 2]);
+      }
+    }
+
+    cellsLayersNum = NF;
+  }
+}
+END {
+  trackletsCoefficients = "";
+
+  for(iLayer = 1; iLayer <= trackletsLayersNum; iLayer++) {
+
+    split("", layerSamples);
+
+    for(iSample = 1; iSample <= trackletsSamplesNum[iLayer]; iSample++) {
+
+      layerSamples[iSample] = trackletsSamples[iLayer, iSample];
+    }
+
+    trackletsCoefficients = trackletsCoefficients (iLayer > 1 ? ", " : "") \
+        sprintf("%.5gf", computeQuantile(layerSamples, trackletsSamplesNum[iLayer]));
+  }
+
+  cellsCoefficients = "";
+
+  for(iLayer = 1; iLayer <= cellsLayersNum; iLayer++) {
+
+    split("", layerSamples);
+
+    for(iSample = 1; iSample <= cellsSamplesNum[iLayer]; iSample++) {
+
+      layerSamples[iSample] = cellsSamples[iLayer, iSample];
+    }
+
+    cellsCoefficients = cellsCoefficients (iLayer > 1 ? ", " : "") \
+        sprintf("%.5gf", computeQuantile(layerSamples, cellsSamplesNum[iLayer]));
+  }
+
+  print "TrackletsMemoryCoefficients { { " trackletsCoefficients " } }"
+  print "CellsMemoryCoefficients { { " cellsCoefficients " } }"
+}
@@ -0,0 +1,82 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file CapacityModel.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_CAPACITYMODEL_H_
+#define TRACKINGITSU_INCLUDE_CAPACITYMODEL_H_
+
+#include <array>
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Constants.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Predicts the tracklets and cells buffer sizes from the clusters number of the involved layers. The coefficients
+/// are a running quantile of the tracklets per clusters pair (cells per clusters triplet) ratio observed on the last
+/// processed vertices, starting from the Constants::Memory values
+class CapacityModel
+    final
+    {
+      public:
+        CapacityModel();
+
+        const MemoryParameters& getMemoryParameters() const;
+        void setMemoryParameters(const MemoryParameters&);
+        float getTrackletsCoefficient(const int) const;
+        float getCellsCoefficient(const int) const;
+        int getTrackletsCapacity(const int, const int, const int) const;
+        int getCellsCapacity(const int, const int, const int, const int) const;
+        void addTrackletsSample(const int, const int, const int, const int);
+        void addCellsSample(const int, const int, const int, const int, const int);
+
+      private:
+        float addSample(std::vector<float>&, int&, std::vector<float>&, const float) const;
+
+        MemoryParameters mMemoryParameters;
+        std::array<float, Constants::ITS::TrackletsPerRoad> mTrackletsCoefficients;
+        std::array<std::vector<float>, Constants::ITS::TrackletsPerRoad> mTrackletsSamples;
+        std::array<std::vector<float>, Constants::ITS::TrackletsPerRoad> mTrackletsSortedSamples;
+        std::array<int, Constants::ITS::TrackletsPerRoad> mTrackletsNextSampleIndex;
+        std::array<float, Constants::ITS::CellsPerRoad> mCellsCoefficients;
+        std::array<std::vector<float>, Constants::ITS::CellsPerRoad> mCellsSamples;
+        std::array<std::vector<float>, Constants::ITS::CellsPerRoad> mCellsSortedSamples;
+        std::array<int, Constants::ITS::CellsPerRoad> mCellsNextSampleIndex;
+    };
+
+    inline const MemoryParameters& CapacityModel::getMemoryParameters() const
+    {
+      return mMemoryParameters;
+    }
+
+    inline float CapacityModel::getTrackletsCoefficient(const int layerIndex) const
+    {
+      return mTrackletsCoefficients[layerIndex];
+    }
+
+    inline float CapacityModel::getCellsCoefficient(const int layerIndex) const
+    {
+      return mCellsCoefficients[layerIndex];
+    }
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_CAPACITYMODEL_H_ */
@@ -0,0 +1,61 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file CellsAutomaton.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_CELLSAUTOMATON_H_
+#define TRACKINGITSU_INCLUDE_CELLSAUTOMATON_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/PrimaryVertexContext.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Computes the cells levels with the synchronous evolution of the cellular automaton: at each round, every cell
+/// having a neighbour in the same state increments its state, all the cells reading the states of the previous
+/// round. A cell that does not increment has reached the length of its longest neighbours chain and stays stable,
+/// so it is dropped from the alive cells bitset of its layer. The evolution ends when no cell is alive, after at
+/// most CellsPerRoad rounds, and gives the same levels as the neighbours finding, independently of the visit order.
+class CellsAutomaton
+    final
+    {
+      public:
+        CellsAutomaton();
+
+        CellsAutomaton(const CellsAutomaton&) = delete;
+        CellsAutomaton &operator=(const CellsAutomaton&) = delete;
+
+        void evolve(PrimaryVertexContext&, const bool);
+
+      private:
+        void initializeLayer(PrimaryVertexContext&, const int);
+        bool evolveLayer(PrimaryVertexContext&, const int);
+
+        std::array<std::vector<unsigned char>, Constants::ITS::CellsPerRoad> mStates;
+        std::array<std::vector<unsigned char>, Constants::ITS::CellsPerRoad> mNextStates;
+        std::array<std::vector<uint64_t>, Constants::ITS::CellsPerRoad> mAliveCells;
+    };
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_CELLSAUTOMATON_H_ */
@@ -30,8 +30,10 @@ namespace CA
 struct Cluster
     final
     {
-      Cluster(const int, const int, const float, const float, const float, const float, const int);
+      Cluster(const int, const int, const float, const float, const float, const float);
       Cluster(const int, const float3&, const Cluster&);
+      /// Copy of a cluster with its phi and r coordinates relative to the origin and its bin already computed
+      Cluster(const Cluster&, const float, const float, const int);
 
       float xCoordinate;
       float yCoordinate;
@@ -40,7 +42,6 @@ struct Cluster
       float rCoordinate;
       int clusterId;
       float alphaAngle;
-      int monteCarloId;
       int indexTableBinIndex;
   };
 
@@ -0,0 +1,145 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Configuration.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_CONFIGURATION_H_
+#define TRACKINGITSU_INCLUDE_CONFIGURATION_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+struct TrackingParameters
+    final
+    {
+      TrackingParameters();
+
+      /// Run the per-layer tracklet, cell and neighbour stages as a dataflow graph of std::async threads, started for
+      /// every vertex and iteration. Off by default, as the threads inherit the affinity of the caller and add up with
+      /// the ones of ParallelTracker and SectorTracker (CPU only)
+      bool pipelinedExecution;
+      /// Drop the tracklets that can not take part in any cell before the cells finding (CPU only)
+      bool trackletsPruning;
+      /// Minimum road level of each tracking iteration. Every iteration after the first one skips the clusters
+      /// already assigned to a road (CPU only, the GPU build runs the first iteration only)
+      std::vector<int> cellsMinimumLevel;
+      /// Label the roads with the Monte Carlo truth of the event. Production runs without truth information disable it
+      bool montecarloLabels;
+      /// Compute the cells levels with the synchronous evolution of the cellular automaton once all the neighbours are
+      /// found, instead of raising them while the neighbours are found layer by layer
+      bool cellsAutomatonEvolution;
+      /// Find the tracklets and the cells phi sector by phi sector over all the layers instead of layer by layer, each
+      /// sector holding the clusters of as many index table rows as fit in Constants::Memory::PhiSectorMaxBytes
+      /// (CPU only, ignored by the pipelined execution)
+      bool phiSectorsTraversal;
+      /// Fit the roads with the Kalman filter and store the resulting tracks alongside the roads
+      bool tracksFitting;
+      /// Upper bounds, in clusters of the searched layer, of the index table occupancy regimes but the last one, which
+      /// takes all the larger occupancies (CPU only)
+      std::vector<int> indexTableRegimesClustersNum;
+      /// Index table granularity (see PaddedLayerGranularity) of each searched layer in each occupancy regime
+      std::vector<std::array<int, Constants::ITS::TrackletsPerRoad>> indexTableGranularities;
+      /// Search engine (see Constants::IndexTable) of each searched layer in each occupancy regime. The grid one uses
+      /// the granularity above
+      std::vector<std::array<int, Constants::ITS::TrackletsPerRoad>> indexTableSearchEngines;
+
+      int getIndexTableRegime(const int) const;
+      int getIndexTableGranularity(const int, const int) const;
+      int getIndexTableSearchEngine(const int, const int) const;
+  };
+
+struct MemoryParameters
+    final
+    {
+      MemoryParameters();
+
+      /// Relative headroom added on top of the predicted tracklets and cells capacities
+      float memoryMargin;
+      /// Quantile of the observed tracklets and cells occupancy ratios used as capacity coefficient
+      float occupancyQuantile;
+      /// Number of processed vertices the occupancy quantile is computed on
+      int samplesNum;
+      /// Whether the per-vertex tracklets and cells arrays larger than a huge page are mapped on huge pages (see
+      /// HugePagesAllocator). Ignored by the GPU tracker
+      bool hugePagesAllocation;
+      /// Bytes the tracklets and cells arrays of a vertex may take, zero for no budget. An event whose predicted or
+      /// actual arrays exceed it is tracked again in overlapping phi and tan(lambda) chunks (see
+      /// Tracker::clustersToTracks), and fails with std::runtime_error if Constants::Memory::MaxChunksNum chunks still
+      /// exceed it. Ignored by the GPU tracker
+      std::size_t memoryBudget;
+      /// Number of vertices after which the tracklets and cells arrays retaining more than shrinkThreshold times the
+      /// largest capacity needed by those vertices are shrunk to it, zero for arrays that only grow
+      int shrinkVerticesNum;
+      /// Ratio of the retained to the needed capacity above which an array is shrunk
+      float shrinkThreshold;
+  };
+
+struct VertexingParameters
+    final
+    {
+      VertexingParameters();
+
+      /// Transverse position of the beam line, used as origin of the tracklets and of the vertices
+      float2 beamPosition;
+      /// Maximum azimuthal distance between consecutive clusters of a tracklet
+      float phiCut;
+      /// Maximum distance along z between the third cluster and the extrapolation of the first two
+      float zCut;
+      /// Maximum distance of a vertex from the nominal interaction point along the beam line
+      float zRange;
+      /// Width of the bins of the tracklets z histogram
+      float binSize;
+      /// Half width of the window around a histogram peak averaged to compute the vertex position
+      float peakWidth;
+      /// Half width of the window around a found vertex whose tracklets are removed from the histogram. Vertices
+      /// closer than this are merged
+      float exclusionWidth;
+      /// Minimum number of tracklets pointing to a vertex
+      int minTrackletsNum;
+      /// Minimum excess of a histogram peak over the mean background of the histogram, in standard deviations
+      float minPeakSignificance;
+      /// Number of threads sharing the tracklets search
+      int threadsNum;
+  };
+
+struct DecompositionParameters
+    final
+    {
+      DecompositionParameters();
+
+      /// Number of phi sectors the event is split in, each one tracked by its own process
+      int sectorsNum;
+      /// Width in phi of the halo added on both sides of each sector. A road is found as in the whole event if it lies
+      /// within the halos of at least one sector holding one of its clusters
+      float haloPhiWidth;
+      /// Number of tan(lambda) slices each phi sector of a single vertex is cut in (see TrackingUtils::splitVertexChunks)
+      int slicesNum;
+      /// Width in tan(lambda), seen from the vertex, of the halo added on both sides of each slice
+      float haloTanLambdaWidth;
+  };
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_CONFIGURATION_H_ */
@@ -31,6 +31,7 @@ namespace Constants {
 namespace Math {
 constexpr float Pi { 3.14159265359f };
 constexpr float TwoPi { 2.0f * Pi };
+constexpr float MaxPhiCoordinate { 6.28318501f }; // Largest float below TwoPi
 constexpr float FloatMinThreshold { 1e-20f };
 }
 
@@ -77,6 +78,15 @@ namespace IndexTable {
 constexpr int ZBins { 20 };
 constexpr int PhiBins { 20 };
 constexpr float InversePhiBinSize { Constants::IndexTable::PhiBins / Constants::Math::TwoPi };
+constexpr int GranularitiesNumber { 4 };
+constexpr int DefaultGranularity { 1 };
+constexpr int GridSearchEngine { 0 };
+constexpr int PhiSortedSearchEngine { 1 };
+constexpr int HierarchicalGridSearchEngine { 2 };
+constexpr int SearchEnginesNumber { 3 };
+constexpr int DefaultSearchEngine { GridSearchEngine };
+constexpr int TuningRegimesNumber { 3 };
+constexpr GPUArray<int, TuningRegimesNumber> TuningRegimesClustersNum { { 2500, 10000, 40000 } };
 GPU_HOST_DEVICE constexpr GPUArray<float, ITS::LayersNumber> InverseZBinSize()
 {
   return GPUArray<float, ITS::LayersNumber> { { 0.5 * ZBins / 16.333f, 0.5 * ZBins / 16.333f, 0.5 * ZBins / 16.333f,
@@ -89,6 +99,18 @@ constexpr GPUArray<float, ITS::TrackletsPerRoad> TrackletsMemoryCoefficients { {
     0.00078135f, 0.00057934f, 0.00052217f } };
 constexpr GPUArray<float, ITS::CellsPerRoad> CellsMemoryCoefficients { { 2.3208e-08f, 2.104e-08f, 1.6432e-08f,
     1.2412e-08f, 1.3543e-08f } };
+constexpr int PhiSectorMaxBytes { 1 << 20 };
+constexpr int PrefetchDistance { 8 };
+constexpr int HugePageShift { 21 };
+constexpr int HugePageSize { 1 << HugePageShift };
+constexpr int MaxPhiSectorsNum { 8 };
+constexpr int MaxChunksNum { 64 };
+}
+
+namespace Fitting {
+constexpr float ClusterResolutionRPhi { 0.0005f };
+constexpr float ClusterResolutionZ { 0.0005f };
+constexpr double InitialCovariance { 1.0 };
 }
 
 namespace PDGCodes {
@@ -42,10 +42,13 @@
 
 # define MATH_ABS abs
 # define MATH_ATAN2 atan2
+# define MATH_COPYSIGN copysign
 # define MATH_MAX max
 # define MATH_MIN min
 # define MATH_SQRT sqrt
 
+# define MEMORY_PREFETCH(address)
+
 # include "ITSReconstruction/CA/gpu/Array.h"
 
 template<typename T, std::size_t Size>
@@ -64,10 +67,13 @@ typedef cudaStream_t GPUStream;
 
 # define MATH_ABS std::abs
 # define MATH_ATAN2 std::atan2
+# define MATH_COPYSIGN std::copysign
 # define MATH_MAX std::max
 # define MATH_MIN std::min
 # define MATH_SQRT std::sqrt
 
+# define MEMORY_PREFETCH(address) __builtin_prefetch(address)
+
 typedef struct _dim3 { unsigned int x, y, z; } dim3;
 typedef struct _int4 { int x, y, z, w; } int4;
 typedef struct _float2 { float x, y; } float2;
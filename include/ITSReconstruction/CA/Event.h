@@ -42,11 +42,14 @@ class Event
       void printPrimaryVertices() const;
       void pushClusterToLayer(const int, const int, const float, const float, const float, const float, const int);
       int getTotalClusters() const;
+      int getMonteCarloId(const int) const;
 
     private:
       const int mEventId;
       std::vector<float3> mPrimaryVertices;
       std::array<Layer, Constants::ITS::LayersNumber> mLayers;
+      /// Monte Carlo truth side table, indexed by cluster id. Kept out of the clusters, it is read only to label roads
+      std::vector<int> mMonteCarloIds;
   };
 
   inline int Event::getEventId() const
@@ -70,6 +73,11 @@ class Event
     return mPrimaryVertices.size();
   }
 
+  inline int Event::getMonteCarloId(const int clusterId) const
+  {
+    return clusterId < static_cast<int>(mMonteCarloIds.size()) ? mMonteCarloIds[clusterId] : Constants::ITS::UnusedIndex;
+  }
+
 }
 }
 }
@@ -0,0 +1,211 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file HierarchicalGridLayer.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_HIERARCHICALGRIDLAYER_H_
+#define TRACKINGITSU_INCLUDE_HIERARCHICALGRIDLAYER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ITSReconstruction/CA/Cluster.h"
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/MathUtils.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Search copy of the clusters of a layer on a two-level grid: a coarse ZBins x PhiBins grid, with phi ghost rows as
+/// in PaddedLayer, whose bins are split in RefinementFactor x RefinementFactor fine bins. The clusters are sorted by
+/// fine bin inside each coarse bin, so that a sparse coarse bin is read as a single range and only the fine bins in
+/// the search window are read from a dense one (more than RefinementThreshold clusters)
+struct HierarchicalGridLayer
+    final
+    {
+      static constexpr int ZBins { 10 };
+      static constexpr int PhiBins { 10 };
+      static constexpr int RefinementFactor { 4 };
+      static constexpr int RefinementThreshold { 16 };
+      static constexpr int GhostPhiBins { static_cast<int>(Constants::Thresholds::PhiCoordinateCut * PhiBins
+          / Constants::Math::TwoPi) + 1 };
+      static constexpr int PaddedPhiBins { PhiBins + 2 * GhostPhiBins };
+      static constexpr int FineZBins { ZBins * RefinementFactor };
+      static constexpr int FinePhiBins { PhiBins * RefinementFactor };
+      static constexpr int FineBinsPerBin { RefinementFactor * RefinementFactor };
+
+      HierarchicalGridLayer();
+
+      void initialize(const std::vector<Cluster>&, const int);
+      /// Bytes allocated on the heap by the search copy
+      std::size_t getMemorySize() const;
+      /// Frees the heap arrays of the search copy, until the next initialization
+      void releaseMemory();
+      /// Index in the layer of the given sorted cluster
+      int getClusterIndex(const int) const;
+      /// Calls rangeFunction(first, max) on the ranges of sorted clusters in the search window of the given cluster
+      template<typename RangeFunction>
+      void forEachCandidatesRange(const Cluster&, const float, RangeFunction&) const;
+
+      int layerIndex;
+      float inverseFineZBinSize;
+      float inverseFinePhiBinSize;
+      std::vector<float> phiCoordinates;
+      std::vector<float> rCoordinates;
+      std::vector<float> zCoordinates;
+      /// Index of the original cluster in the layer
+      std::vector<int> clusterIndexes;
+
+    private:
+      int getFineZBinIndex(const float) const;
+      int getFinePhiBinIndex(const float) const;
+      /// Index in the fine table of a fine bin, the fine phi bin possibly in the ghost rows
+      int getFineTableIndex(const int, const int) const;
+      void addCluster(const Cluster&, const int, const float);
+
+      /// First sorted cluster of each fine bin, grouped by coarse bin
+      std::array<int, ZBins * PaddedPhiBins * FineBinsPerBin + 1> mFineIndexTable;
+      std::vector<int> mPaddedClusterIndexes;
+      std::vector<float> mPaddedPhiCoordinates;
+      std::vector<int> mPaddedFineTableIndexes;
+      std::vector<int> mSortedPaddedIndexes;
+  };
+
+inline int HierarchicalGridLayer::getFineZBinIndex(const float zCoordinate) const
+{
+  return (zCoordinate + Constants::ITS::LayersZCoordinate()[layerIndex]) * inverseFineZBinSize;
+}
+
+inline int HierarchicalGridLayer::getFinePhiBinIndex(const float phiCoordinate) const
+{
+  return phiCoordinate * inverseFinePhiBinSize;
+}
+
+inline int HierarchicalGridLayer::getFineTableIndex(const int fineZIndex, const int finePhiIndex) const
+{
+  const int paddedFinePhiIndex { finePhiIndex + GhostPhiBins * RefinementFactor };
+
+  return (((paddedFinePhiIndex / RefinementFactor) * ZBins + fineZIndex / RefinementFactor) * RefinementFactor
+      + paddedFinePhiIndex % RefinementFactor) * RefinementFactor + fineZIndex % RefinementFactor;
+}
+
+inline int HierarchicalGridLayer::getClusterIndex(const int sortedClusterIndex) const
+{
+  return clusterIndexes[sortedClusterIndex];
+}
+
+template<typename RangeFunction>
+inline void HierarchicalGridLayer::forEachCandidatesRange(const Cluster& currentCluster,
+    const float directionZIntersection, RangeFunction& rangeFunction) const
+{
+  const float zRangeMin = directionZIntersection - 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMin = currentCluster.phiCoordinate - Constants::Thresholds::PhiCoordinateCut;
+  const float zRangeMax = directionZIntersection + 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMax = currentCluster.phiCoordinate + Constants::Thresholds::PhiCoordinateCut;
+
+  if (zRangeMax < -Constants::ITS::LayersZCoordinate()[layerIndex]
+      || zRangeMin > Constants::ITS::LayersZCoordinate()[layerIndex] || zRangeMin > zRangeMax) {
+
+    return;
+  }
+
+  const int minFineZIndex { std::max(0, getFineZBinIndex(zRangeMin)) };
+  const int maxFineZIndex { std::min(FineZBins - 1, getFineZBinIndex(zRangeMax)) };
+  int minFinePhiIndex { getFinePhiBinIndex(MathUtils::getNormalizedPhiCoordinate(phiRangeMin)) };
+  int maxFinePhiIndex { getFinePhiBinIndex(MathUtils::getNormalizedPhiCoordinate(phiRangeMax)) };
+
+  /// A window crossing phi = 0 continues into the ghost rows on the side of the current cluster
+  if (maxFinePhiIndex < minFinePhiIndex) {
+
+    if (currentCluster.phiCoordinate < Constants::Math::Pi) {
+
+      minFinePhiIndex -= FinePhiBins;
+
+    } else {
+
+      maxFinePhiIndex += FinePhiBins;
+    }
+  }
+
+  const int firstPhiBin { (minFinePhiIndex + GhostPhiBins * RefinementFactor) / RefinementFactor - GhostPhiBins };
+  const int lastPhiBin { (maxFinePhiIndex + GhostPhiBins * RefinementFactor) / RefinementFactor - GhostPhiBins };
+  int pendingFirstIndex { 0 };
+  int pendingMaxIndex { 0 };
+
+  for (int iPhiBin { firstPhiBin }; iPhiBin <= lastPhiBin; ++iPhiBin) {
+
+    const int minSubPhiIndex { std::max(0, minFinePhiIndex - iPhiBin * RefinementFactor) };
+    const int maxSubPhiIndex { std::min(RefinementFactor - 1, maxFinePhiIndex - iPhiBin * RefinementFactor) };
+
+    for (int iZBin { minFineZIndex / RefinementFactor }; iZBin <= maxFineZIndex / RefinementFactor; ++iZBin) {
+
+      const int firstFineTableIndex { ((iPhiBin + GhostPhiBins) * ZBins + iZBin) * FineBinsPerBin };
+      const int firstBinIndex { mFineIndexTable[firstFineTableIndex] };
+      const int maxBinIndex { mFineIndexTable[firstFineTableIndex + FineBinsPerBin] };
+
+      if (maxBinIndex - firstBinIndex <= RefinementThreshold) {
+
+        if (firstBinIndex != pendingMaxIndex) {
+
+          if (pendingFirstIndex < pendingMaxIndex) {
+
+            rangeFunction(pendingFirstIndex, pendingMaxIndex);
+          }
+
+          pendingFirstIndex = firstBinIndex;
+        }
+
+        pendingMaxIndex = maxBinIndex;
+        continue;
+      }
+
+      const int minSubZIndex { std::max(0, minFineZIndex - iZBin * RefinementFactor) };
+      const int maxSubZIndex { std::min(RefinementFactor - 1, maxFineZIndex - iZBin * RefinementFactor) };
+
+      for (int iSubPhiIndex { minSubPhiIndex }; iSubPhiIndex <= maxSubPhiIndex; ++iSubPhiIndex) {
+
+        const int rowFineTableIndex { firstFineTableIndex + iSubPhiIndex * RefinementFactor };
+        const int firstRowIndex { mFineIndexTable[rowFineTableIndex + minSubZIndex] };
+
+        if (firstRowIndex != pendingMaxIndex) {
+
+          if (pendingFirstIndex < pendingMaxIndex) {
+
+            rangeFunction(pendingFirstIndex, pendingMaxIndex);
+          }
+
+          pendingFirstIndex = firstRowIndex;
+        }
+
+        pendingMaxIndex = mFineIndexTable[rowFineTableIndex + maxSubZIndex + 1];
+      }
+    }
+  }
+
+  if (pendingFirstIndex < pendingMaxIndex) {
+
+    rangeFunction(pendingFirstIndex, pendingMaxIndex);
+  }
+}
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_HIERARCHICALGRIDLAYER_H_ */
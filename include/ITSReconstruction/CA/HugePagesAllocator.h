@@ -0,0 +1,152 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file HugePagesAllocator.h
+/// \brief
+///
+
+
+#ifndef TRACKINGITSU_INCLUDE_HUGEPAGESALLOCATOR_H_
+#define TRACKINGITSU_INCLUDE_HUGEPAGESALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+namespace MemoryUtils
+{
+/// Maps the given number of bytes, rounded up to a multiple of Constants::Memory::HugePageSize, on explicit huge
+/// pages or, if none is available, on an aligned anonymous mapping advised for transparent huge pages
+void* allocateHugePages(const std::size_t);
+void deallocateHugePages(void*, const std::size_t);
+}
+
+/// Allocator of the large per-vertex arrays. If enabled, the allocations of at least one huge page are served by
+/// MemoryUtils::allocateHugePages, the smaller ones (and all of them if disabled) by the global operator new.
+/// Not final, as the standard containers may derive from their allocator
+template<typename T>
+class HugePagesAllocator
+{
+  public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    HugePagesAllocator();
+    explicit HugePagesAllocator(const bool);
+    template<typename U>
+    HugePagesAllocator(const HugePagesAllocator<U>&);
+
+    T* allocate(const std::size_t);
+    void deallocate(T*, const std::size_t);
+    bool isHugePagesEnabled() const;
+
+  private:
+    bool usesHugePages(const std::size_t) const;
+
+    bool mHugePagesEnabled;
+};
+
+/// The device code keeps the standard allocator, the host copies of its arrays being filled from plain vectors
+#if TRACKINGITSU_GPU_MODE
+template<typename T>
+using HugePagesVector = std::vector<T>;
+#else
+template<typename T>
+using HugePagesVector = std::vector<T, HugePagesAllocator<T>>;
+#endif
+
+template<typename T>
+HugePagesAllocator<T>::HugePagesAllocator()
+    : mHugePagesEnabled { false }
+{
+  // Nothing to do
+}
+
+template<typename T>
+HugePagesAllocator<T>::HugePagesAllocator(const bool hugePagesEnabled)
+    : mHugePagesEnabled { hugePagesEnabled }
+{
+  // Nothing to do
+}
+
+template<typename T>
+template<typename U>
+HugePagesAllocator<T>::HugePagesAllocator(const HugePagesAllocator<U>& other)
+    : mHugePagesEnabled { other.isHugePagesEnabled() }
+{
+  // Nothing to do
+}
+
+template<typename T>
+T* HugePagesAllocator<T>::allocate(const std::size_t elementsNum)
+{
+  if (usesHugePages(elementsNum)) {
+
+    return static_cast<T*>(MemoryUtils::allocateHugePages(elementsNum * sizeof(T)));
+  }
+
+  return static_cast<T*>(::operator new(elementsNum * sizeof(T)));
+}
+
+template<typename T>
+void HugePagesAllocator<T>::deallocate(T* pointer, const std::size_t elementsNum)
+{
+  if (usesHugePages(elementsNum)) {
+
+    MemoryUtils::deallocateHugePages(pointer, elementsNum * sizeof(T));
+
+  } else {
+
+    ::operator delete(pointer);
+  }
+}
+
+template<typename T>
+inline bool HugePagesAllocator<T>::isHugePagesEnabled() const
+{
+  return mHugePagesEnabled;
+}
+
+template<typename T>
+inline bool HugePagesAllocator<T>::usesHugePages(const std::size_t elementsNum) const
+{
+  return mHugePagesEnabled && elementsNum * sizeof(T) >= static_cast<std::size_t>(Constants::Memory::HugePageSize);
+}
+
+template<typename T, typename U>
+inline bool operator==(const HugePagesAllocator<T>& first, const HugePagesAllocator<U>& second)
+{
+  return first.isHugePagesEnabled() == second.isHugePagesEnabled();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const HugePagesAllocator<T>& first, const HugePagesAllocator<U>& second)
+{
+  return !(first == second);
+}
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_HUGEPAGESALLOCATOR_H_ */
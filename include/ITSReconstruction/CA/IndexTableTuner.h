@@ -0,0 +1,74 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file IndexTableTuner.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_INDEXTABLETUNER_H_
+#define TRACKINGITSU_INCLUDE_INDEXTABLETUNER_H_
+
+#include <array>
+#include <ostream>
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/PrimaryVertexContext.h"
+#include "ITSReconstruction/CA/Tracker.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+/// Benchmarks the tracklets finding of every searched layer with each search engine, and each compiled granularity of
+/// the grid one, on a set of events, and selects for each layer and occupancy regime the fastest configuration
+class IndexTableTuner
+    final : private TrackerTraits<false>
+    {
+      public:
+        IndexTableTuner();
+        explicit IndexTableTuner(const std::vector<int>&);
+
+        IndexTableTuner(const IndexTableTuner&) = delete;
+        IndexTableTuner &operator=(const IndexTableTuner&) = delete;
+
+        void tune(const std::vector<Event>&, TrackingParameters&);
+        void printReport(std::ostream&) const;
+
+      private:
+        /// The grid engine with every granularity, then the other engines
+        static constexpr int ConfigurationsNumber { Constants::IndexTable::GranularitiesNumber
+            + Constants::IndexTable::SearchEnginesNumber - 1 };
+        typedef std::array<std::array<double, ConfigurationsNumber>, Constants::ITS::TrackletsPerRoad> LayersTimes;
+
+        static int getConfigurationSearchEngine(const int);
+        static int getConfigurationGranularity(const int);
+        static int getConfigurationIndex(const int, const int);
+
+        std::vector<int> mRegimesClustersNum;
+        std::vector<LayersTimes> mRegimesTimes;
+        std::vector<std::array<int, Constants::ITS::TrackletsPerRoad>> mRegimesSamplesNum;
+        std::vector<std::array<int, Constants::ITS::TrackletsPerRoad>> mRegimesConfigurations;
+        PrimaryVertexContext mPrimaryVertexContext;
+    };
+#endif
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_INDEXTABLETUNER_H_ */
@@ -38,7 +38,7 @@ class Layer
       const std::vector<Cluster>& getClusters() const;
       const Cluster& getCluster(int) const;
       int getClustersSize() const;
-      void addCluster(const int, const float, const float, const float, const float, const int);
+      void addCluster(const int, const float, const float, const float, const float);
 
     private:
       int mLayerIndex;
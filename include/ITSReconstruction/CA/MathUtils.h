@@ -15,6 +15,7 @@
 #ifndef TRACKINGITSU_INCLUDE_CAUTILS_H_
 #define TRACKINGITSU_INCLUDE_CAUTILS_H_
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 
@@ -30,13 +31,18 @@ namespace CA
 namespace MathUtils {
 float calculatePhiCoordinate(const float, const float);
 float calculateRCoordinate(const float, const float);
+void calculatePhiCoordinates(const float*, const float*, const float, const float, float*, const int);
+void calculateRCoordinates(const float*, const float*, const float, const float, float*, const int);
+GPU_HOST_DEVICE float fastAtan2(const float, const float);
 GPU_HOST_DEVICE constexpr float getNormalizedPhiCoordinate(const float);
 GPU_HOST_DEVICE constexpr float3 crossProduct(const float3&, const float3&);
 }
 
+/// Phi coordinate in [0, 2 pi): a point on or just below the positive x axis, at 2 pi after the rounding, is clamped
+/// to the last float below it so that its phi bin is always valid
 inline float MathUtils::calculatePhiCoordinate(const float xCoordinate, const float yCoordinate)
 {
-  return std::atan2(-yCoordinate, -xCoordinate) + Constants::Math::Pi;
+  return MATH_MIN(fastAtan2(-yCoordinate, -xCoordinate) + Constants::Math::Pi, Constants::Math::MaxPhiCoordinate);
 }
 
 inline float MathUtils::calculateRCoordinate(const float xCoordinate, const float yCoordinate)
@@ -44,10 +50,37 @@ inline float MathUtils::calculateRCoordinate(const float xCoordinate, const floa
   return std::sqrt(xCoordinate * xCoordinate + yCoordinate * yCoordinate);
 }
 
+/// Polynomial atan2 in [-pi, pi]: minimax odd polynomial of degree 15 of the ratio of the smaller to the larger
+/// argument, then octant reconstruction. The maximum absolute error is 3.2e-7 rad (2.5e-7 for the float std::atan2),
+/// far below the phi bins width and the phi cuts, test/check_fast_atan2.sh verifies it. The octant selections are
+/// arithmetic on selected constants so that loops calling it are vectorised, and the signs are taken with copysign
+/// so that signed zeros give the same half plane as std::atan2. The ReferenceAtan2 build type uses std::atan2
+GPU_HOST_DEVICE inline float MathUtils::fastAtan2(const float yCoordinate, const float xCoordinate)
+{
+#if defined(REFERENCE_ATAN2)
+  return MATH_ATAN2(yCoordinate, xCoordinate);
+#else
+  const float absoluteXCoordinate { MATH_ABS(xCoordinate) };
+  const float absoluteYCoordinate { MATH_ABS(yCoordinate) };
+  const float ratio { MATH_MIN(absoluteXCoordinate, absoluteYCoordinate)
+      / (MATH_MAX(absoluteXCoordinate, absoluteYCoordinate) + Constants::Math::FloatMinThreshold) };
+  const float quadraticRatio { ratio * ratio };
+  const float octantAngle { ratio * (0.999999336f + quadraticRatio * (-0.333298608f + quadraticRatio * (0.199465655f
+      + quadraticRatio * (-0.139086287f + quadraticRatio * (0.0964219508f + quadraticRatio * (-0.0559122938f
+          + quadraticRatio * (0.0218629337f - quadraticRatio * 0.00405456018f))))))) };
+  const bool isSteep { absoluteYCoordinate > absoluteXCoordinate };
+  const float quadrantAngle { (isSteep ? Constants::Math::Pi / 2 : 0.f) + (isSteep ? -1.f : 1.f) * octantAngle };
+  const bool isNegativeX { MATH_COPYSIGN(1.f, xCoordinate) < 0.f };
+  const float halfPlaneAngle { (isNegativeX ? Constants::Math::Pi : 0.f) + (isNegativeX ? -1.f : 1.f) * quadrantAngle };
+
+  return MATH_COPYSIGN(halfPlaneAngle, yCoordinate);
+#endif
+}
+
 GPU_HOST_DEVICE constexpr float MathUtils::getNormalizedPhiCoordinate(const float phiCoordinate)
 {
   return (phiCoordinate < 0) ? phiCoordinate + Constants::Math::TwoPi :
-         (phiCoordinate > Constants::Math::TwoPi) ? phiCoordinate - Constants::Math::TwoPi : phiCoordinate;
+         (phiCoordinate >= Constants::Math::TwoPi) ? phiCoordinate - Constants::Math::TwoPi : phiCoordinate;
 }
 
 GPU_HOST_DEVICE constexpr float3 MathUtils::crossProduct(const float3& firstVector,
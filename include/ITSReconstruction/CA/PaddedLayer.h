@@ -0,0 +1,265 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PaddedLayer.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_PADDEDLAYER_H_
+#define TRACKINGITSU_INCLUDE_PADDEDLAYER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ITSReconstruction/CA/Cluster.h"
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Search copy of the clusters of a layer, sorted by the bins of an index table of ZBinsNum x PhiBinsNum bins and
+/// stored as structure of arrays. The clusters of the last (first) GhostPhiBins phi bins are duplicated in front of
+/// (after) the layer with their phi coordinate shifted by -2 pi (+2 pi), and the index table has the matching ghost
+/// rows, so that a phi window crossing phi = 0 is a sequence of consecutive rows and the phi difference needs no
+/// wrap around test. A layer small enough for 16 bit indexes stores the index table and the cluster indexes in the
+/// compact arrays, halving their cache footprint
+template<int ZBinsNum, int PhiBinsNum>
+struct PaddedLayer
+    final
+    {
+      static constexpr int ZBins { ZBinsNum };
+      static constexpr int PhiBins { PhiBinsNum };
+      static constexpr int GhostPhiBins { static_cast<int>(Constants::Thresholds::PhiCoordinateCut * PhiBinsNum
+          / Constants::Math::TwoPi) + 1 };
+      static constexpr int PaddedPhiBins { PhiBinsNum + 2 * GhostPhiBins };
+      static constexpr int RowBitmapWords { (ZBinsNum + 63) / 64 };
+
+      PaddedLayer();
+
+      void initialize(const std::vector<Cluster>&, const int);
+      /// Bytes allocated on the heap by the search copy
+      std::size_t getMemorySize() const;
+      /// Frees the heap arrays of the search copy, until the next initialization
+      void releaseMemory();
+      int getZBinIndex(const float) const;
+      int getPhiBinIndex(const float) const;
+      int getPaddedBinIndex(const int, const int) const;
+      /// First padded cluster of the given padded bin, the bins of a row being consecutive
+      int getBinFirstClusterIndex(const int) const;
+      /// Index in the layer of the given padded cluster
+      int getClusterIndex(const int) const;
+      /// Whether any of the z bins from the first to the second one (included) of the given phi row holds a cluster
+      bool isRowRangeOccupied(const int, const int, const int) const;
+      /// Selected bins of the search window, with phi bins possibly in the ghost rows, or an empty rectangle (z < x)
+      int4 getBinsRect(const Cluster&, const float) const;
+      /// Calls rangeFunction(first, max) on the ranges of padded clusters in the search window of the given cluster
+      template<typename RangeFunction>
+      void forEachCandidatesRange(const Cluster&, const float, RangeFunction&) const;
+
+      int layerIndex;
+      float inverseZBinSize;
+      float inversePhiBinSize;
+      /// Whether the index table and the cluster indexes are stored on 16 bits, chosen at initialization
+      bool compactIndexes;
+      /// One bit per bin of the index table, set if the bin holds a cluster, RowBitmapWords words per phi row
+      std::array<uint64_t, PaddedPhiBins * RowBitmapWords> occupancyBitmap;
+      std::vector<float> phiCoordinates;
+      std::vector<float> rCoordinates;
+      std::vector<float> zCoordinates;
+
+    private:
+      void addCluster(const Cluster&, const int, const float);
+      void setBinFirstClusterIndex(const int, const int);
+
+      std::array<int, ZBinsNum * PaddedPhiBins + 1> mIndexTable;
+      std::array<uint16_t, ZBinsNum * PaddedPhiBins + 1> mCompactIndexTable;
+      std::vector<int> mClusterIndexes;
+      std::vector<uint16_t> mCompactClusterIndexes;
+
+      std::vector<int> mClustersBinIndexes;
+      std::vector<int> mSortedClusterIndexes;
+  };
+
+template<int ZBinsNum, int PhiBinsNum>
+inline int PaddedLayer<ZBinsNum, PhiBinsNum>::getZBinIndex(const float zCoordinate) const
+{
+  return (zCoordinate + Constants::ITS::LayersZCoordinate()[layerIndex]) * inverseZBinSize;
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline int PaddedLayer<ZBinsNum, PhiBinsNum>::getPhiBinIndex(const float phiCoordinate) const
+{
+  return phiCoordinate * inversePhiBinSize;
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline int PaddedLayer<ZBinsNum, PhiBinsNum>::getPaddedBinIndex(const int zIndex, const int phiIndex) const
+{
+  return (phiIndex + GhostPhiBins) * ZBinsNum + zIndex;
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline int PaddedLayer<ZBinsNum, PhiBinsNum>::getBinFirstClusterIndex(const int paddedBinIndex) const
+{
+  return compactIndexes ? mCompactIndexTable[paddedBinIndex] : mIndexTable[paddedBinIndex];
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline int PaddedLayer<ZBinsNum, PhiBinsNum>::getClusterIndex(const int paddedClusterIndex) const
+{
+  return compactIndexes ? mCompactClusterIndexes[paddedClusterIndex] : mClusterIndexes[paddedClusterIndex];
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline void PaddedLayer<ZBinsNum, PhiBinsNum>::setBinFirstClusterIndex(const int paddedBinIndex,
+    const int paddedClusterIndex)
+{
+  if (compactIndexes) {
+
+    mCompactIndexTable[paddedBinIndex] = paddedClusterIndex;
+
+  } else {
+
+    mIndexTable[paddedBinIndex] = paddedClusterIndex;
+  }
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+inline bool PaddedLayer<ZBinsNum, PhiBinsNum>::isRowRangeOccupied(const int phiIndex, const int minZIndex,
+    const int maxZIndex) const
+{
+  const int rowFirstWordIndex { (phiIndex + GhostPhiBins) * RowBitmapWords };
+  const int lastWordIndex { maxZIndex / 64 };
+
+  for (int iWord { minZIndex / 64 }; iWord <= lastWordIndex; ++iWord) {
+
+    uint64_t wordMask { ~uint64_t { 0 } };
+
+    if (iWord == minZIndex / 64) {
+
+      wordMask &= ~uint64_t { 0 } << (minZIndex % 64);
+    }
+
+    if (iWord == lastWordIndex) {
+
+      wordMask &= ~uint64_t { 0 } >> (63 - maxZIndex % 64);
+    }
+
+    if (occupancyBitmap[rowFirstWordIndex + iWord] & wordMask) {
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+template<typename RangeFunction>
+inline void PaddedLayer<ZBinsNum, PhiBinsNum>::forEachCandidatesRange(const Cluster& currentCluster,
+    const float directionZIntersection, RangeFunction& rangeFunction) const
+{
+  const int4 selectedBinsRect { getBinsRect(currentCluster, directionZIntersection) };
+
+  if (selectedBinsRect.z < selectedBinsRect.x) {
+
+    return;
+  }
+
+  for (int iPhiBin { selectedBinsRect.y }; iPhiBin <= selectedBinsRect.w; ++iPhiBin) {
+
+    if (!isRowRangeOccupied(iPhiBin, selectedBinsRect.x, selectedBinsRect.z)) {
+
+      continue;
+    }
+
+    const int firstBinIndex { getPaddedBinIndex(selectedBinsRect.x, iPhiBin) };
+    const int maxBinIndex { firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1 };
+
+    rangeFunction(getBinFirstClusterIndex(firstBinIndex), getBinFirstClusterIndex(maxBinIndex));
+  }
+}
+
+/// The index table granularities compiled in, selected at runtime per layer by index
+template<int Granularity>
+struct PaddedLayerGranularity;
+
+template<>
+struct PaddedLayerGranularity<0>
+{
+    typedef PaddedLayer<10, 10> Type;
+};
+
+template<>
+struct PaddedLayerGranularity<1>
+{
+    typedef PaddedLayer<Constants::IndexTable::ZBins, Constants::IndexTable::PhiBins> Type;
+};
+
+template<>
+struct PaddedLayerGranularity<2>
+{
+    typedef PaddedLayer<40, 40> Type;
+};
+
+template<>
+struct PaddedLayerGranularity<3>
+{
+    typedef PaddedLayer<80, 80> Type;
+};
+
+/// Calls function with the std::integral_constant of the runtime granularity, trying every compiled in granularity
+template<int Granularity>
+struct PaddedLayerGranularityDispatcher
+{
+    template<typename Function>
+    static void dispatch(const int granularity, Function& function)
+    {
+      if (granularity == Granularity) {
+
+        function(std::integral_constant<int, Granularity> { });
+        return;
+      }
+
+      PaddedLayerGranularityDispatcher<Granularity + 1>::dispatch(granularity, function);
+    }
+};
+
+template<>
+struct PaddedLayerGranularityDispatcher<Constants::IndexTable::GranularitiesNumber>
+{
+    template<typename Function>
+    static void dispatch(const int, Function&)
+    {
+      throw std::runtime_error("Invalid index table granularity");
+    }
+};
+
+template<typename Function>
+inline void dispatchGranularity(const int granularity, Function&& function)
+{
+  PaddedLayerGranularityDispatcher<0>::dispatch(granularity, function);
+}
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_PADDEDLAYER_H_ */
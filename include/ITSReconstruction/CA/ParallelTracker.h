@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ParallelTracker.h
+/// \brief
+///
+
+
+#ifndef TRACKINGITSU_INCLUDE_PARALLELTRACKER_H_
+#define TRACKINGITSU_INCLUDE_PARALLELTRACKER_H_
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/Road.h"
+#include "ITSReconstruction/CA/Track.h"
+#include "ITSReconstruction/CA/Tracker.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+/// Tracks a set of events on a pool of workers spread over the NUMA nodes. Each worker is pinned to a core of its
+/// node and owns a Tracker, whose vertex context is built by the pinned worker and thus first-touched on the local
+/// node. The events are dealt out to the nodes in proportion to their workers and each event is copied by the worker
+/// that tracks it, so that a worker only reads memory of its own node. The parallelism is across the events, the
+/// workers always run the stages of an event serially
+class ParallelTracker
+    final
+    {
+      public:
+        ParallelTracker();
+        explicit ParallelTracker(const TrackingParameters&);
+        ParallelTracker(const TrackingParameters&, const int);
+
+        ParallelTracker(const ParallelTracker&) = delete;
+        ParallelTracker &operator=(const ParallelTracker&) = delete;
+
+        std::vector<std::vector<std::vector<Road>>> clustersToTracks(const std::vector<Event>&);
+
+        int getNodesNum() const;
+        int getWorkersNum() const;
+        const std::vector<std::vector<std::vector<Track>>>& getTracks() const;
+
+      private:
+        void placeWorkers(const int);
+        void runWorker(const int, const std::vector<Event>&, std::vector<std::vector<std::vector<Road>>>&);
+        void trackNodeEvents(const int, Tracker<false>&, const std::vector<Event>&,
+            std::vector<std::vector<std::vector<Road>>>&);
+
+        TrackingParameters mTrackingParameters;
+        /// Usable cpus of each NUMA node
+        std::vector<std::vector<int>> mNodesCpus;
+        std::vector<int> mWorkersNodes;
+        std::vector<int> mWorkersCpus;
+        /// Kept across the calls, so that every worker reuses the buffers it first-touched
+        std::vector<std::unique_ptr<Tracker<false>>> mWorkersTrackers;
+        std::vector<std::exception_ptr> mWorkersExceptions;
+        std::vector<std::vector<int>> mNodesEvents;
+        std::vector<int> mNodesNextEvents;
+        std::mutex mNodesEventsMutex;
+        std::vector<std::vector<std::vector<Track>>> mTracks;
+    };
+
+    inline int ParallelTracker::getNodesNum() const
+    {
+      return mNodesCpus.size();
+    }
+
+    inline int ParallelTracker::getWorkersNum() const
+    {
+      return mWorkersNodes.size();
+    }
+
+    inline const std::vector<std::vector<std::vector<Track>>>& ParallelTracker::getTracks() const
+    {
+      return mTracks;
+    }
+#endif
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_PARALLELTRACKER_H_ */
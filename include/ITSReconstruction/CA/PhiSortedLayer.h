@@ -0,0 +1,126 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PhiSortedLayer.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_PHISORTEDLAYER_H_
+#define TRACKINGITSU_INCLUDE_PHISORTEDLAYER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "ITSReconstruction/CA/Cluster.h"
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Search copy of the clusters of a layer sorted by phi and cut in blocks of BlockSize clusters, each block sorted by
+/// z. The clusters closer than the phi cut to phi = 0 are duplicated on the other side with their phi coordinate
+/// shifted by 2 pi. A query binary searches the first block of the phi window and the z window inside every block
+/// of the phi window, so that the search cost follows the local occupancy instead of a fixed binning
+struct PhiSortedLayer
+    final
+    {
+      static constexpr int BlockSize { 32 };
+
+      PhiSortedLayer();
+
+      void initialize(const std::vector<Cluster>&, const int);
+      /// Bytes allocated on the heap by the search copy
+      std::size_t getMemorySize() const;
+      /// Frees the heap arrays of the search copy, until the next initialization
+      void releaseMemory();
+      /// Index in the layer of the given sorted cluster
+      int getClusterIndex(const int) const;
+      /// Calls rangeFunction(first, max) on the ranges of sorted clusters in the search window of the given cluster
+      template<typename RangeFunction>
+      void forEachCandidatesRange(const Cluster&, const float, RangeFunction&) const;
+
+      int layerIndex;
+      std::vector<float> phiCoordinates;
+      std::vector<float> rCoordinates;
+      std::vector<float> zCoordinates;
+      /// Index of the original cluster in the layer
+      std::vector<int> clusterIndexes;
+
+    private:
+      void addCluster(const Cluster&, const int, const float);
+
+      /// Index and (shifted) phi coordinate of the clusters and of their duplicates, before sorting
+      std::vector<int> mPaddedClusterIndexes;
+      std::vector<float> mPaddedPhiCoordinates;
+      std::vector<int> mSortedPaddedIndexes;
+      /// Largest phi coordinate of each block, in increasing order
+      std::vector<float> mBlocksMaxPhiCoordinates;
+  };
+
+inline int PhiSortedLayer::getClusterIndex(const int sortedClusterIndex) const
+{
+  return clusterIndexes[sortedClusterIndex];
+}
+
+template<typename RangeFunction>
+inline void PhiSortedLayer::forEachCandidatesRange(const Cluster& currentCluster, const float directionZIntersection,
+    RangeFunction& rangeFunction) const
+{
+  const float zRangeMin = directionZIntersection - 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMin = currentCluster.phiCoordinate - Constants::Thresholds::PhiCoordinateCut;
+  const float zRangeMax = directionZIntersection + 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMax = currentCluster.phiCoordinate + Constants::Thresholds::PhiCoordinateCut;
+
+  if (zRangeMax < -Constants::ITS::LayersZCoordinate()[layerIndex]
+      || zRangeMin > Constants::ITS::LayersZCoordinate()[layerIndex] || zRangeMin > zRangeMax) {
+
+    return;
+  }
+
+  const int blocksNum { static_cast<int>(mBlocksMaxPhiCoordinates.size()) };
+  const int clustersNum { static_cast<int>(zCoordinates.size()) };
+  int iBlock { static_cast<int>(std::lower_bound(mBlocksMaxPhiCoordinates.begin(), mBlocksMaxPhiCoordinates.end(),
+      phiRangeMin) - mBlocksMaxPhiCoordinates.begin()) };
+
+  for (; iBlock < blocksNum; ++iBlock) {
+
+    const int firstBlockClusterIndex { iBlock * BlockSize };
+
+    if (iBlock > 0 && mBlocksMaxPhiCoordinates[iBlock - 1] > phiRangeMax) {
+
+      break;
+    }
+
+    const std::vector<float>::const_iterator blockBegin { zCoordinates.begin() + firstBlockClusterIndex };
+    const std::vector<float>::const_iterator blockEnd { zCoordinates.begin()
+        + std::min(clustersNum, firstBlockClusterIndex + BlockSize) };
+    const int firstClusterIndex { static_cast<int>(std::lower_bound(blockBegin, blockEnd, zRangeMin)
+        - zCoordinates.begin()) };
+    const int maxClusterIndex { static_cast<int>(std::upper_bound(blockBegin, blockEnd, zRangeMax)
+        - zCoordinates.begin()) };
+
+    if (firstClusterIndex < maxClusterIndex) {
+
+      rangeFunction(firstClusterIndex, maxClusterIndex);
+    }
+  }
+}
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_PHISORTEDLAYER_H_ */
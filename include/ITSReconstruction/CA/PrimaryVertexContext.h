@@ -17,13 +17,22 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
+#include "ITSReconstruction/CA/CapacityModel.h"
 #include "ITSReconstruction/CA/Cell.h"
 #include "ITSReconstruction/CA/Constants.h"
 #include "ITSReconstruction/CA/Definitions.h"
 #include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/HierarchicalGridLayer.h"
+#include "ITSReconstruction/CA/HugePagesAllocator.h"
+#include "ITSReconstruction/CA/PaddedLayer.h"
+#include "ITSReconstruction/CA/PhiSortedLayer.h"
 #include "ITSReconstruction/CA/Road.h"
 #include "ITSReconstruction/CA/Tracklet.h"
 
@@ -39,6 +48,15 @@ namespace ITS
 namespace CA
 {
 
+/// Thrown when the tracklets or cells of a layer would grow past the enforced memory budget
+struct MemoryBudgetExceeded final : public std::runtime_error
+{
+    MemoryBudgetExceeded()
+        : std::runtime_error { "Memory budget exceeded" }
+    {
+    }
+};
+
 class PrimaryVertexContext
     final
     {
@@ -49,12 +67,24 @@ class PrimaryVertexContext
         PrimaryVertexContext &operator=(const PrimaryVertexContext&) = delete;
 
         void initialize(const Event&, const int);
+        void initializeClusters(const Event&, const float3&);
+        void initializeVertex(const float3&);
+        void initializeIteration();
+        const Event& getEvent() const;
         const float3& getPrimaryVertex() const;
         std::array<std::vector<Cluster>, Constants::ITS::LayersNumber>& getClusters();
-        std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad>& getCells();
+        std::array<HugePagesVector<Cell>, Constants::ITS::CellsPerRoad>& getCells();
         std::array<std::vector<int>, Constants::ITS::CellsPerRoad - 1>& getCellsLookupTable();
         std::array<std::vector<std::vector<int>>, Constants::ITS::CellsPerRoad - 1>& getCellsNeighbours();
+        std::array<std::vector<int>, Constants::ITS::CellsPerRoad>& getCellsLevelsIndexes();
+        std::array<std::array<int, Constants::ITS::CellsPerRoad + 2>, Constants::ITS::CellsPerRoad>& getCellsLevelsLookupTable();
+        void sortCellsByLevel(const int);
         std::vector<Road>& getRoads();
+        const CapacityModel& getCapacityModel() const;
+        CapacityModel& getCapacityModel();
+        /// Sets the memory parameters of the capacity model and reallocates the empty tracklets and cells arrays with
+        /// the selected allocation. Must not be called while an event is processed
+        void setMemoryParameters(const MemoryParameters&);
 
 #if TRACKINGITSU_GPU_MODE
         GPU::PrimaryVertexContext& getDeviceContext();
@@ -70,19 +100,77 @@ class PrimaryVertexContext
         std::array<GPU::Vector<Cell>, Constants::ITS::CellsPerRoad - 1>& getTempCellArray();
         void updateDeviceContext();
 #else
-        std::array<std::array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
-            Constants::ITS::TrackletsPerRoad>& getIndexTables();
-        std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad>& getTracklets();
+        std::array<int, Constants::ITS::TrackletsPerRoad>& getIndexTableSearchEngines();
+        std::array<int, Constants::ITS::TrackletsPerRoad>& getIndexTableGranularities();
+        template<int Granularity>
+        std::array<typename PaddedLayerGranularity<Granularity>::Type, Constants::ITS::TrackletsPerRoad>& getPaddedLayers();
+        std::array<PhiSortedLayer, Constants::ITS::TrackletsPerRoad>& getPhiSortedLayers();
+        std::array<HierarchicalGridLayer, Constants::ITS::TrackletsPerRoad>& getHierarchicalGridLayers();
+        std::array<HugePagesVector<Tracklet>, Constants::ITS::TrackletsPerRoad>& getTracklets();
         std::array<std::vector<int>, Constants::ITS::CellsPerRoad>& getTrackletsLookupTable();
+        std::array<std::vector<unsigned char>, Constants::ITS::CellsPerRoad>& getIncomingTrackletsTable();
+        std::array<std::vector<bool>, Constants::ITS::LayersNumber>& getUsedClustersTable();
+        void buildTrackletsLookupTable(const int);
+        void buildCellsLookupTable(const int);
+        void sampleTrackletsOccupancy(const int);
+        void sampleCellsOccupancy(const int);
+        /// Size in bytes of the arrays of a vertex of the given event, the tracklets and cells capacities being
+        /// predicted by the capacity model and the neighbours counted as one per cell
+        std::size_t getPredictedMemorySize(const Event&) const;
+        /// Bounds the tracklets and cells arrays, with the entries indexing them, to the memory budget left by the
+        /// clusters arrays of the event. The capacity reserved for each layer is capped to its share of that budget,
+        /// in proportion to the predicted capacities. No bound if the budget is zero
+        void setMemoryBudget(const Event&, const std::size_t);
+        /// Grow the full tracklets or cells of a layer within the memory budget, throw MemoryBudgetExceeded if it is
+        /// exhausted. Nothing to do if no budget is set
+        void growTracklets(const int);
+        void growCells(const int);
+        /// Size in bytes currently allocated on the heap by the per-vertex arrays: the clusters, their search copies
+        /// and used clusters table, the tracklets, cells, neighbours and roads and their lookup tables
+        std::size_t getMemorySize() const;
+        /// Frees the tracklets and cells arrays and their lookup tables, keeping their allocators
+        void releaseMemory();
+        /// Frees the clusters arrays, their search copies and used clusters table, until the next initialization
+        void releaseClustersMemory();
 #endif
 
       private:
+#if !TRACKINGITSU_GPU_MODE
+        void updateHighWaterMarks();
+        void applyShrinkPolicy();
+        /// Predicted capacities of the tracklets and cells of the event, returns the bytes of the arrays sized by its
+        /// clusters only
+        std::size_t predictCapacities(const Event&, std::array<int, Constants::ITS::TrackletsPerRoad>&,
+            std::array<int, Constants::ITS::CellsPerRoad>&) const;
+        /// Bytes of the arrays bounded by the memory budget, as counted by getPredictedMemorySize
+        std::size_t getArraysMemorySize() const;
+        /// Reserves up to the given capacity, as far as the memory budget allows, returns whether the array grew
+        template<typename T, typename Allocator>
+        bool reserveCapacity(std::vector<T, Allocator>&, const std::size_t, const std::size_t);
+        template<typename T, typename Allocator>
+        void growCapacity(std::vector<T, Allocator>&, const std::size_t);
+#endif
+
+        const Event* mEvent;
         float3 mPrimaryVertex;
         std::array<std::vector<Cluster>, Constants::ITS::LayersNumber> mClusters;
-        std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad> mCells;
+        /// Coordinates and bins of the clusters of the layer being initialized, as arrays for the batch transform and
+        /// the counting sort by bin
+        std::vector<float> mLayerXCoordinates;
+        std::vector<float> mLayerYCoordinates;
+        std::vector<float> mLayerZCoordinates;
+        std::vector<float> mLayerPhiCoordinates;
+        std::vector<float> mLayerRCoordinates;
+        std::vector<int> mLayerBinIndexes;
+        std::vector<int> mLayerBinsOffsets;
+        std::vector<int> mLayerSortedClusterIndexes;
+        std::array<HugePagesVector<Cell>, Constants::ITS::CellsPerRoad> mCells;
         std::array<std::vector<int>, Constants::ITS::CellsPerRoad - 1> mCellsLookupTable;
         std::array<std::vector<std::vector<int>>, Constants::ITS::CellsPerRoad - 1> mCellsNeighbours;
+        std::array<std::vector<int>, Constants::ITS::CellsPerRoad> mCellsLevelsIndexes;
+        std::array<std::array<int, Constants::ITS::CellsPerRoad + 2>, Constants::ITS::CellsPerRoad> mCellsLevelsLookupTable;
         std::vector<Road> mRoads;
+        CapacityModel mCapacityModel;
 
 #if TRACKINGITSU_GPU_MODE
         GPU::PrimaryVertexContext mGPUContext;
@@ -91,13 +179,37 @@ class PrimaryVertexContext
         std::array<GPU::Vector<Tracklet>, Constants::ITS::CellsPerRoad> mTempTrackletArray;
         std::array<GPU::Vector<Cell>, Constants::ITS::CellsPerRoad - 1> mTempCellArray;
 #else
-        std::array<std::array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
-            Constants::ITS::TrackletsPerRoad> mIndexTables;
-        std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad> mTracklets;
+        std::array<int, Constants::ITS::TrackletsPerRoad> mIndexTableSearchEngines;
+        std::array<int, Constants::ITS::TrackletsPerRoad> mIndexTableGranularities;
+        std::tuple<std::array<PaddedLayerGranularity<0>::Type, Constants::ITS::TrackletsPerRoad>,
+            std::array<PaddedLayerGranularity<1>::Type, Constants::ITS::TrackletsPerRoad>,
+            std::array<PaddedLayerGranularity<2>::Type, Constants::ITS::TrackletsPerRoad>,
+            std::array<PaddedLayerGranularity<3>::Type, Constants::ITS::TrackletsPerRoad>> mPaddedLayers;
+        std::array<PhiSortedLayer, Constants::ITS::TrackletsPerRoad> mPhiSortedLayers;
+        std::array<HierarchicalGridLayer, Constants::ITS::TrackletsPerRoad> mHierarchicalGridLayers;
+        std::array<HugePagesVector<Tracklet>, Constants::ITS::TrackletsPerRoad> mTracklets;
         std::array<std::vector<int>, Constants::ITS::CellsPerRoad> mTrackletsLookupTable;
+        std::array<std::vector<unsigned char>, Constants::ITS::CellsPerRoad> mIncomingTrackletsTable;
+        std::array<std::vector<bool>, Constants::ITS::LayersNumber> mUsedClustersTable;
+        /// Largest clusters, tracklets and cells numbers needed since the last application of the shrink policy
+        std::array<int, Constants::ITS::LayersNumber> mClustersHighWaterMarks;
+        std::array<int, Constants::ITS::TrackletsPerRoad> mTrackletsHighWaterMarks;
+        std::array<int, Constants::ITS::CellsPerRoad> mCellsHighWaterMarks;
+        int mShrinkVerticesCount;
+        /// Shares of the memory budget capping the capacities reserved for the tracklets and cells of each layer
+        std::array<int, Constants::ITS::TrackletsPerRoad> mTrackletsCapacityShares;
+        std::array<int, Constants::ITS::CellsPerRoad> mCellsCapacityShares;
+        /// Bytes the arrays bounded by the memory budget may take and currently take
+        std::size_t mArraysMemoryBudget;
+        std::atomic<std::size_t> mArraysMemorySize;
 #endif
     };
 
+    inline const Event& PrimaryVertexContext::getEvent() const
+    {
+      return *mEvent;
+    }
+
     inline const float3& PrimaryVertexContext::getPrimaryVertex() const
     {
       return mPrimaryVertex;
@@ -108,7 +220,7 @@ class PrimaryVertexContext
       return mClusters;
     }
 
-    inline std::array<std::vector<Cell>, Constants::ITS::CellsPerRoad>& PrimaryVertexContext::getCells()
+    inline std::array<HugePagesVector<Cell>, Constants::ITS::CellsPerRoad>& PrimaryVertexContext::getCells()
     {
       return mCells;
     }
@@ -123,11 +235,31 @@ class PrimaryVertexContext
       return mCellsNeighbours;
     }
 
+    inline std::array<std::vector<int>, Constants::ITS::CellsPerRoad>& PrimaryVertexContext::getCellsLevelsIndexes()
+    {
+      return mCellsLevelsIndexes;
+    }
+
+    inline std::array<std::array<int, Constants::ITS::CellsPerRoad + 2>, Constants::ITS::CellsPerRoad>& PrimaryVertexContext::getCellsLevelsLookupTable()
+    {
+      return mCellsLevelsLookupTable;
+    }
+
     inline std::vector<Road>& PrimaryVertexContext::getRoads()
     {
       return mRoads;
     }
 
+    inline const CapacityModel& PrimaryVertexContext::getCapacityModel() const
+    {
+      return mCapacityModel;
+    }
+
+    inline CapacityModel& PrimaryVertexContext::getCapacityModel()
+    {
+      return mCapacityModel;
+    }
+
 #if TRACKINGITSU_GPU_MODE
     inline GPU::PrimaryVertexContext& PrimaryVertexContext::getDeviceContext()
     {
@@ -189,13 +321,33 @@ class PrimaryVertexContext
       mGPUContextDevicePointer = GPU::UniquePointer<GPU::PrimaryVertexContext> { mGPUContext };
     }
 #else
-    inline std::array<std::array<int, Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins + 1>,
-        Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getIndexTables()
+    inline std::array<int, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getIndexTableSearchEngines()
+    {
+      return mIndexTableSearchEngines;
+    }
+
+    inline std::array<int, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getIndexTableGranularities()
+    {
+      return mIndexTableGranularities;
+    }
+
+    template<int Granularity>
+    inline std::array<typename PaddedLayerGranularity<Granularity>::Type, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getPaddedLayers()
+    {
+      return std::get<Granularity>(mPaddedLayers);
+    }
+
+    inline std::array<PhiSortedLayer, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getPhiSortedLayers()
     {
-      return mIndexTables;
+      return mPhiSortedLayers;
     }
 
-    inline std::array<std::vector<Tracklet>, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getTracklets()
+    inline std::array<HierarchicalGridLayer, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getHierarchicalGridLayers()
+    {
+      return mHierarchicalGridLayers;
+    }
+
+    inline std::array<HugePagesVector<Tracklet>, Constants::ITS::TrackletsPerRoad>& PrimaryVertexContext::getTracklets()
     {
       return mTracklets;
     }
@@ -204,6 +356,16 @@ class PrimaryVertexContext
     {
       return mTrackletsLookupTable;
     }
+
+    inline std::array<std::vector<unsigned char>, Constants::ITS::CellsPerRoad>& PrimaryVertexContext::getIncomingTrackletsTable()
+    {
+      return mIncomingTrackletsTable;
+    }
+
+    inline std::array<std::vector<bool>, Constants::ITS::LayersNumber>& PrimaryVertexContext::getUsedClustersTable()
+    {
+      return mUsedClustersTable;
+    }
 #endif
 
 }
@@ -0,0 +1,83 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file SectorTracker.h
+/// \brief
+///
+
+
+#ifndef TRACKINGITSU_INCLUDE_SECTORTRACKER_H_
+#define TRACKINGITSU_INCLUDE_SECTORTRACKER_H_
+
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/Track.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+/// Splits an event in overlapping phi sectors and tracks each one with its own Tracker in a forked process. The sectors
+/// and the found tracks go through a local socket pair as raw memory, which only holds between processes of the same
+/// binary on the same host, and the sectors take the tracking parameters of the parent. The per-vertex tracks of all
+/// the sectors are then merged: a track is dropped if its clusters are all part of a longer or equal track already
+/// kept, the copy of the sector owning the innermost cluster being preferred. This drops the copies found in the halos
+/// and the pieces of the tracks curving out of a halo, while keeping such tracks from the sector that found them whole
+class SectorTracker
+    final
+    {
+      public:
+        SectorTracker();
+        SectorTracker(const TrackingParameters&, const DecompositionParameters&);
+
+        SectorTracker(const SectorTracker&) = delete;
+        SectorTracker &operator=(const SectorTracker&) = delete;
+
+        std::vector<std::vector<Track>> clustersToTracks(const Event&);
+
+        const TrackingParameters& getTrackingParameters() const;
+        const DecompositionParameters& getDecompositionParameters() const;
+
+      private:
+        void serveSector(const int) const;
+        void splitEvent(const Event&);
+        void mergeSectorsTracks(std::vector<std::vector<Track>>&);
+
+        TrackingParameters mTrackingParameters;
+        DecompositionParameters mDecompositionParameters;
+        std::vector<Event> mSectorEvents;
+        /// Sector owning each cluster, indexed by cluster id
+        std::vector<int> mClustersSectors;
+        std::vector<std::vector<std::vector<Track>>> mSectorsTracks;
+    };
+
+    inline const TrackingParameters& SectorTracker::getTrackingParameters() const
+    {
+      return mTrackingParameters;
+    }
+
+    inline const DecompositionParameters& SectorTracker::getDecompositionParameters() const
+    {
+      return mDecompositionParameters;
+    }
+#endif
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_SECTORTRACKER_H_ */
@@ -0,0 +1,54 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Track.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_TRACK_H_
+#define TRACKINGITSU_INCLUDE_TRACK_H_
+
+#include <array>
+
+#include "ITSReconstruction/CA/Constants.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// A road resolved to the ids of its clusters, with the helix parameters at the primary vertex
+struct Track
+    final
+    {
+      Track();
+
+      std::array<int, Constants::ITS::LayersNumber> clusterIds;
+      /// Signed inverse of the transverse radius of curvature
+      float curvature;
+      /// Azimuthal direction at the point of closest approach to the primary vertex
+      float phiCoordinate;
+      /// Signed transverse distance of closest approach to the primary vertex
+      float impactParameter;
+      /// z coordinate at the point of closest approach, relative to the primary vertex
+      float zCoordinate;
+      float tanLambda;
+      float chi2;
+      int degreesOfFreedom;
+      int label;
+  };
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_TRACK_H_ */
@@ -0,0 +1,74 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file TrackFitter.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_TRACKFITTER_H_
+#define TRACKINGITSU_INCLUDE_TRACKFITTER_H_
+
+#include <array>
+#include <vector>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/PrimaryVertexContext.h"
+#include "ITSReconstruction/CA/Track.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Fits the roads of a primary vertex with a Kalman filter in a constant, uniform magnetic field without material.
+/// In the transverse plane the clusters are mapped to the conformal space, where a circle through the primary vertex
+/// becomes the parabola v = a + b * u + c * u^2, so that the measurement model is linear; along the beam line the
+/// track is a straight line in the transverse arc length. The tracks are fitted in batches stored as structures of
+/// arrays, the innermost loops run over the tracks of a batch without branches and can be vectorised.
+class TrackFitter
+    final
+    {
+      public:
+        TrackFitter();
+
+        TrackFitter(const TrackFitter&) = delete;
+        TrackFitter &operator=(const TrackFitter&) = delete;
+
+        void fitRoads(PrimaryVertexContext&, std::vector<Track>&);
+
+      private:
+        static constexpr int BatchSize { 32 };
+        typedef std::array<double, BatchSize> BatchArray;
+
+        void loadBatch(PrimaryVertexContext&, const int, const int, Track*);
+        void fitBatch();
+        void storeBatch(const int, Track*) const;
+
+        std::array<BatchArray, Constants::ITS::LayersNumber> mUCoordinates;
+        std::array<BatchArray, Constants::ITS::LayersNumber> mVCoordinates;
+        std::array<BatchArray, Constants::ITS::LayersNumber> mVVariances;
+        std::array<BatchArray, Constants::ITS::LayersNumber> mRCoordinates;
+        std::array<BatchArray, Constants::ITS::LayersNumber> mZCoordinates;
+        std::array<BatchArray, Constants::ITS::LayersNumber> mWeights;
+        BatchArray mRotationAngles;
+        std::array<BatchArray, 3> mTransverseParameters;
+        std::array<BatchArray, 6> mTransverseCovariances;
+        std::array<BatchArray, 2> mLongitudinalParameters;
+        std::array<BatchArray, 3> mLongitudinalCovariances;
+        BatchArray mChi2;
+    };
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_TRACKFITTER_H_ */
@@ -16,6 +16,7 @@
 #define TRACKINGITSU_INCLUDE_TRACKER_H_
 
 #include <array>
+#include <cstddef>
 #include <cmath>
 #include <ctime>
 #include <fstream>
@@ -23,11 +24,16 @@
 #include <iostream>
 #include <memory>
 
+#include "ITSReconstruction/CA/CellsAutomaton.h"
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Constants.h"
 #include "ITSReconstruction/CA/Definitions.h"
 #include "ITSReconstruction/CA/Event.h"
 #include "ITSReconstruction/CA/MathUtils.h"
 #include "ITSReconstruction/CA/PrimaryVertexContext.h"
 #include "ITSReconstruction/CA/Road.h"
+#include "ITSReconstruction/CA/Track.h"
+#include "ITSReconstruction/CA/TrackFitter.h"
 
 namespace o2
 {
@@ -42,6 +48,11 @@ class TrackerTraits
   public:
     void computeLayerTracklets(PrimaryVertexContext&);
     void computeLayerCells(PrimaryVertexContext&);
+    void computeLayerTracklets(PrimaryVertexContext&, const int);
+    void computeLayerCells(PrimaryVertexContext&, const int);
+    void computePhiSectorsTracklets(PrimaryVertexContext&);
+    void computePhiSectorsCells(PrimaryVertexContext&);
+    void pruneLayerTracklets(PrimaryVertexContext&, const int);
 
   protected:
     ~TrackerTraits() = default;
@@ -52,34 +63,139 @@ class Tracker: private TrackerTraits<IsGPU>
 {
   private:
     typedef TrackerTraits<IsGPU> Trait;
+    /// Instrumentation of trackEvent requested by the verbose and benchmark drivers
+    enum class TrackingReport
+    {
+      None, Verbose, Memory, Time
+    };
+    /// Occupancy of the arrays of a vertex in its first iteration, written by the memory benchmark
+    struct VertexOccupancy final
+    {
+        std::array<std::size_t, Constants::ITS::LayersNumber> clustersSizes;
+        std::array<std::size_t, Constants::ITS::TrackletsPerRoad> trackletsCapacities;
+        std::array<std::size_t, Constants::ITS::TrackletsPerRoad> trackletsSizes;
+        std::array<std::size_t, Constants::ITS::CellsPerRoad> cellsCapacities;
+        std::array<std::size_t, Constants::ITS::CellsPerRoad> cellsSizes;
+    };
   public:
     Tracker();
+    explicit Tracker(const TrackingParameters&);
+    Tracker(const TrackingParameters&, const MemoryParameters&);
 
     Tracker(const Tracker&) = delete;
     Tracker &operator=(const Tracker&) = delete;
 
+    /// The cells of the returned roads index the context of their vertex, which the next vertex overwrites. When the
+    /// memory budget splits the event in chunks the roads only carry their label and fake flag, their cells being
+    /// cleared, and the clusters of each road are given as event cluster ids by the tracks of getTracks
     std::vector<std::vector<Road>> clustersToTracks(const Event&);
     std::vector<std::vector<Road>> clustersToTracksVerbose(const Event&);
     std::vector<std::vector<Road>> clustersToTracksMemoryBenchmark(const Event&, std::ofstream&);
     std::vector<std::vector<Road>> clustersToTracksTimeBenchmark(const Event&, std::ofstream&);
 
+    const TrackingParameters& getTrackingParameters() const;
+    void setTrackingParameters(const TrackingParameters&);
+    const MemoryParameters& getMemoryParameters() const;
+    void setMemoryParameters(const MemoryParameters&);
+    const std::vector<std::vector<Track>>& getTracks() const;
+#if !TRACKINGITSU_GPU_MODE
+    /// Bytes currently retained by the per-vertex arrays of the context
+    std::size_t getRetainedMemorySize() const;
+#endif
+
   protected:
+    void selectIndexTables(const Event&);
     void computeTracklets();
+    void findLayerTracklets(const int);
+    void pruneTracklets();
     void computeCells();
     void findCellsNeighbours();
+    void findLayerCellsNeighbours(const int);
+    void computePipelinedStages();
     void findTracks();
     void traverseCellsTree(const int, const int);
+    void markUsedClusters();
     void computeMontecarloLabels();
+    void fitTracks();
 
   private:
+    /// Tracks all the vertices of the event, returns false if the arrays of a vertex exceeded the enforced budget
+    bool trackEvent(const Event&, std::vector<std::vector<Road>>&);
+    bool trackEventChunks(const Event&, const int, std::vector<std::vector<Road>>&);
+    /// Appends the roads of the context and keeps the tracks fitted from them, in the chunked mode only the ones
+    /// owned by the current chunk, whose cells are cleared
+    void collectRoads(std::vector<Road>&, const int);
+    bool isMemoryBudgetExceeded() const;
+    std::vector<std::vector<Road>> clustersToTracksReport(const Event&, const TrackingReport, std::ostream&);
+    void recordCapacities(VertexOccupancy&);
+    void recordSizes(VertexOccupancy&);
+    void reportVertex(const int, const std::array<float, 6>&, const float, const VertexOccupancy&,
+        const std::size_t) const;
+    /// Runs a stage, timed and reported only when the tracker is instrumented
     float evaluateTask(void (Tracker<IsGPU>::*)(void), const char*);
-    float evaluateTask(void (Tracker<IsGPU>::*)(void), const char*, std::ostream&);
 
+    TrackingParameters mTrackingParameters;
     PrimaryVertexContext mPrimaryVertexContext;
+    int mCurrentIteration;
+    CellsAutomaton mCellsAutomaton;
+    TrackFitter mTrackFitter;
+    std::vector<std::vector<Track>> mTracks;
+    /// Memory budget of the event being tracked, zero if not enforced
+    std::size_t mEnforcedMemoryBudget;
+    /// Chunk owning each cluster, indexed by cluster id, and chunk being tracked in the chunked mode
+    std::vector<int> mClustersChunks;
+    int mCurrentChunk;
+    TrackingReport mReport;
+    std::ostream* mReportStream;
 };
 
+template<bool IsGPU>
+inline const TrackingParameters& Tracker<IsGPU>::getTrackingParameters() const
+{
+  return mTrackingParameters;
+}
+
+template<bool IsGPU>
+inline void Tracker<IsGPU>::setTrackingParameters(const TrackingParameters& trackingParameters)
+{
+  mTrackingParameters = trackingParameters;
+}
+
+template<bool IsGPU>
+inline const MemoryParameters& Tracker<IsGPU>::getMemoryParameters() const
+{
+  return mPrimaryVertexContext.getCapacityModel().getMemoryParameters();
+}
+
+template<bool IsGPU>
+inline void Tracker<IsGPU>::setMemoryParameters(const MemoryParameters& memoryParameters)
+{
+  mPrimaryVertexContext.setMemoryParameters(memoryParameters);
+}
+
+template<bool IsGPU>
+inline const std::vector<std::vector<Track>>& Tracker<IsGPU>::getTracks() const
+{
+  return mTracks;
+}
+
+#if !TRACKINGITSU_GPU_MODE
+template<bool IsGPU>
+inline std::size_t Tracker<IsGPU>::getRetainedMemorySize() const
+{
+  return mPrimaryVertexContext.getMemorySize();
+}
+#endif
+
 template<> void TrackerTraits<TRACKINGITSU_GPU_MODE>::computeLayerTracklets(PrimaryVertexContext&);
 template<> void TrackerTraits<TRACKINGITSU_GPU_MODE>::computeLayerCells(PrimaryVertexContext&);
+#if !TRACKINGITSU_GPU_MODE
+template<> void TrackerTraits<false>::computeLayerTracklets(PrimaryVertexContext&, const int);
+template<> void TrackerTraits<false>::computeLayerCells(PrimaryVertexContext&, const int);
+template<> void TrackerTraits<false>::computePhiSectorsTracklets(PrimaryVertexContext&);
+template<> void TrackerTraits<false>::computePhiSectorsCells(PrimaryVertexContext&);
+template<> void TrackerTraits<false>::pruneLayerTracklets(PrimaryVertexContext&, const int);
+#endif
 
 }
 }
@@ -15,8 +15,12 @@
 #ifndef TRACKINGITSU_INCLUDE_TRACKINGUTILS_H_
 #define TRACKINGITSU_INCLUDE_TRACKINGUTILS_H_
 
+#include <vector>
+
 #include "ITSReconstruction/CA/Cluster.h"
+#include "ITSReconstruction/CA/Configuration.h"
 #include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/Event.h"
 
 namespace o2
 {
@@ -28,6 +32,18 @@ namespace CA
 namespace TrackingUtils {
 GPU_HOST_DEVICE constexpr int4 getEmptyBinsRect() { return int4{ 0, 0, 0, 0 }; }
 GPU_DEVICE const int4 getBinsRect(const Cluster&, const int, const float);
+#if !TRACKINGITSU_GPU_MODE
+/// Splits an event in overlapping phi sectors cut around the mean transverse position of its vertices. Each sector
+/// event holds all the vertices and the clusters of the sector and of its halos, and the sector owning each cluster is
+/// stored at the index of its cluster id
+void splitPhiSectors(const Event&, const DecompositionParameters&, std::vector<Event>&, std::vector<int>&);
+/// Splits the clusters of an event seen from one of its vertices in overlapping phi sectors, each one cut in
+/// overlapping tan(lambda) slices of about as many clusters. The chunk event of the slice l of the sector s, at the
+/// index s * slicesNum + l, holds the vertex alone and the clusters of the chunk and of its halos, and the chunk
+/// owning each cluster is stored at the index of its cluster id
+void splitVertexChunks(const Event&, const int, const DecompositionParameters&, std::vector<Event>&,
+    std::vector<int>&);
+#endif
 }
 
 }
@@ -30,10 +30,10 @@ struct Tracklet
       Tracklet();
       GPU_DEVICE Tracklet(const int, const int, const Cluster&, const Cluster&);
 
-      const int firstClusterIndex;
-      const int secondClusterIndex;
-      const float tanLambda;
-      const float phiCoordinate;
+      int firstClusterIndex;
+      int secondClusterIndex;
+      float tanLambda;
+      float phiCoordinate;
   };
 
 }
@@ -0,0 +1,78 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Vertexer.h
+/// \brief
+///
+
+#ifndef TRACKINGITSU_INCLUDE_VERTEXER_H_
+#define TRACKINGITSU_INCLUDE_VERTEXER_H_
+
+#include <array>
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/Event.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Finds the primary vertices of an event from the tracklets of the three innermost layers. Every tracklet with a
+/// compatible cluster on the third layer is extrapolated to the beam line and the vertices are the peaks of the
+/// histogram of the extrapolated z coordinates.
+class Vertexer
+    final
+    {
+      public:
+        Vertexer();
+        explicit Vertexer(const VertexingParameters&);
+
+        Vertexer(const Vertexer&) = delete;
+        Vertexer &operator=(const Vertexer&) = delete;
+
+        const VertexingParameters& getVertexingParameters() const;
+        void setVertexingParameters(const VertexingParameters&);
+        std::vector<float3> findVertices(const Event&);
+        void computeVertices(Event&);
+
+      private:
+        static constexpr int LayersNumber { 3 };
+
+        void initializeLayers(const Event&);
+        void findLayerTracklets(const int, const int, std::vector<float>&) const;
+
+        VertexingParameters mVertexingParameters;
+        std::array<std::vector<float>, LayersNumber> mPhiCoordinates;
+        std::array<std::vector<float>, LayersNumber> mRCoordinates;
+        std::array<std::vector<float>, LayersNumber> mZCoordinates;
+        std::vector<float> mTrackletsZCoordinates;
+        std::vector<int> mHistogram;
+    };
+
+    inline const VertexingParameters& Vertexer::getVertexingParameters() const
+    {
+      return mVertexingParameters;
+    }
+
+    inline void Vertexer::setVertexingParameters(const VertexingParameters& vertexingParameters)
+    {
+      mVertexingParameters = vertexingParameters;
+    }
+
+}
+}
+}
+
+#endif /* TRACKINGITSU_INCLUDE_VERTEXER_H_ */
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -5,8 +6,10 @@
 #include <vector>
 
 #include "ITSReconstruction/CA/Definitions.h"
+#include "ITSReconstruction/CA/IndexTableTuner.h"
 #include "ITSReconstruction/CA/IOUtils.h"
 #include "ITSReconstruction/CA/Tracker.h"
+#include "ITSReconstruction/CA/Vertexer.h"
 
 #if defined HAVE_VALGRIND
 # include <valgrind/callgrind.h>
@@ -42,12 +45,6 @@ int main(int argc, char** argv)
   std::ofstream duplicateRoadsOutputStream;
   std::ofstream fakeRoadsOutputStream;
 
-  int verticesNum = 0;
-  for (int iEvent = 0; iEvent < eventsNum; ++iEvent) {
-
-    verticesNum += events[iEvent].getPrimaryVerticesNum();
-  }
-
   if (argv[2] != NULL) {
 
     std::string labelsFileName(argv[2]);
@@ -60,8 +57,11 @@ int main(int argc, char** argv)
     fakeRoadsOutputStream.open(benchmarkFolderName + "FakeRoads.txt");
   }
 
-  clock_t t1, t2;
+  // Vertices counted after the vertexer ran on the events without truth vertices, whose time is kept apart
+  int verticesNum = 0;
+  std::chrono::time_point<std::chrono::steady_clock> t0, t1, t2;
   float totalTime = 0.f, minTime = std::numeric_limits<float>::max(), maxTime = -1;
+  float totalVertexingTime = 0.f;
 #if defined MEMORY_BENCHMARK
   std::ofstream memoryBenchmarkOutputStream;
   memoryBenchmarkOutputStream.open(benchmarkFolderName + "MemoryOccupancy.txt");
@@ -70,10 +70,24 @@ int main(int argc, char** argv)
   timeBenchmarkOutputStream.open(benchmarkFolderName + "TimeOccupancy.txt");
 #endif
 
+  // Roads are labelled with the Monte Carlo truth only when it is used to produce the benchmark data
+  TrackingParameters trackingParameters{};
+  trackingParameters.montecarloLabels = createBenchmarkData;
+
+#if defined INDEX_TABLE_TUNING && !TRACKINGITSU_GPU_MODE
+  // Select the index table granularities on the loaded events before the tracker is built
+  IndexTableTuner indexTableTuner{};
+  indexTableTuner.tune(events, trackingParameters);
+  indexTableTuner.printReport(std::cout);
+  std::cout << std::endl;
+#endif
+
   // Prevent cold cache benchmark noise
-  Tracker<TRACKINGITSU_GPU_MODE> tracker{};
+  Tracker<TRACKINGITSU_GPU_MODE> tracker{ trackingParameters };
   tracker.clustersToTracks(events[0]);
 
+  Vertexer vertexer{};
+
 #if defined GPU_PROFILING_MODE
   Utils::Host::gpuStartProfiler();
 #endif
@@ -83,14 +97,26 @@ int main(int argc, char** argv)
     Event& currentEvent = events[iEvent];
     std::cout << "Processing event " << iEvent + 1 << std::endl;
 
-    t1 = clock();
+    try {
+      if (currentEvent.getPrimaryVerticesNum() == 0) {
+
+        t0 = std::chrono::steady_clock::now();
+        vertexer.computeVertices(currentEvent);
+        const float vertexingTime = std::chrono::duration<float, std::milli> { std::chrono::steady_clock::now() - t0 }.count();
+        totalVertexingTime += vertexingTime;
+
+        std::cout << "Found " << currentEvent.getPrimaryVerticesNum() << " primary vertices in: " << vertexingTime
+            << "ms" << std::endl;
+      }
+
+      verticesNum += currentEvent.getPrimaryVerticesNum();
+      t1 = std::chrono::steady_clock::now();
 
 #if defined HAVE_VALGRIND
-    // Run callgrind with --collect-atstart=no
-    CALLGRIND_TOGGLE_COLLECT;
+      // Run callgrind with --collect-atstart=no
+      CALLGRIND_TOGGLE_COLLECT;
 #endif
 
-    try {
 #if defined(MEMORY_BENCHMARK)
       std::vector<std::vector<Road>> roads = tracker.clustersToTracksMemoryBenchmark(currentEvent, memoryBenchmarkOutputStream);
 #elif defined(DEBUG)
@@ -105,8 +131,8 @@ int main(int argc, char** argv)
       CALLGRIND_TOGGLE_COLLECT;
 #endif
 
-      t2 = clock();
-      const float diff = ((float) t2 - (float) t1) / (CLOCKS_PER_SEC / 1000);
+      t2 = std::chrono::steady_clock::now();
+      const float diff = std::chrono::duration<float, std::milli> { t2 - t1 }.count();
 
       totalTime += diff;
 
@@ -122,6 +148,10 @@ int main(int argc, char** argv)
 
       std::cout << "Event " << iEvent + 1 << " processed in: " << diff << "ms" << std::endl;
 
+#if defined(MEMORY_BENCHMARK) && !TRACKINGITSU_GPU_MODE
+      std::cout << "Retained vertex context memory: " << tracker.getRetainedMemorySize() << " bytes" << std::endl;
+#endif
+
       if(currentEvent.getPrimaryVerticesNum() > 1) {
 
         std::cout << "Vertex processing mean time: " << diff / currentEvent.getPrimaryVerticesNum() << "ms" << std::endl;
@@ -146,7 +176,16 @@ int main(int argc, char** argv)
 #endif
 
   std::cout << std::endl;
-  std::cout << "Avg time: " << totalTime / verticesNum << "ms" << std::endl;
+  if (verticesNum > 0) {
+
+    std::cout << "Avg time: " << totalTime / verticesNum << "ms" << std::endl;
+
+  } else {
+
+    std::cout << "Avg time: no primary vertex found" << std::endl;
+  }
+
+  std::cout << "Vertexing time: " << totalVertexingTime << "ms" << std::endl;
   std::cout << "Min time: " << minTime << "ms" << std::endl;
   std::cout << "Max time: " << maxTime << "ms" << std::endl;
 
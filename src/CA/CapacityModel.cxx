@@ -0,0 +1,124 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file CapacityModel.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/CapacityModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+CapacityModel::CapacityModel()
+{
+  setMemoryParameters(mMemoryParameters);
+}
+
+void CapacityModel::setMemoryParameters(const MemoryParameters& memoryParameters)
+{
+  mMemoryParameters = memoryParameters;
+
+  /// The coefficients learned with the previous parameters start again from the priors
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mTrackletsCoefficients[iLayer] = Constants::Memory::TrackletsMemoryCoefficients[iLayer];
+    mTrackletsSamples[iLayer].clear();
+    mTrackletsNextSampleIndex[iLayer] = 0;
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      mCellsCoefficients[iLayer] = Constants::Memory::CellsMemoryCoefficients[iLayer];
+      mCellsSamples[iLayer].clear();
+      mCellsNextSampleIndex[iLayer] = 0;
+    }
+  }
+}
+
+int CapacityModel::getTrackletsCapacity(const int layerIndex, const int firstLayerClustersNum,
+    const int secondLayerClustersNum) const
+{
+  return static_cast<int>(std::ceil(
+      ((mTrackletsCoefficients[layerIndex] * firstLayerClustersNum) * secondLayerClustersNum)
+          * (1.f + mMemoryParameters.memoryMargin)));
+}
+
+int CapacityModel::getCellsCapacity(const int layerIndex, const int firstLayerClustersNum,
+    const int secondLayerClustersNum, const int thirdLayerClustersNum) const
+{
+  return static_cast<int>(std::ceil(
+      (((mCellsCoefficients[layerIndex] * firstLayerClustersNum) * secondLayerClustersNum) * thirdLayerClustersNum)
+          * (1.f + mMemoryParameters.memoryMargin)));
+}
+
+void CapacityModel::addTrackletsSample(const int layerIndex, const int firstLayerClustersNum,
+    const int secondLayerClustersNum, const int trackletsNum)
+{
+  const float clustersPairsNum { static_cast<float>(firstLayerClustersNum) * secondLayerClustersNum };
+
+  if (clustersPairsNum <= 0.f) {
+
+    return;
+  }
+
+  mTrackletsCoefficients[layerIndex] = addSample(mTrackletsSamples[layerIndex], mTrackletsNextSampleIndex[layerIndex],
+      mTrackletsSortedSamples[layerIndex], trackletsNum / clustersPairsNum);
+}
+
+void CapacityModel::addCellsSample(const int layerIndex, const int firstLayerClustersNum,
+    const int secondLayerClustersNum, const int thirdLayerClustersNum, const int cellsNum)
+{
+  const float clustersTripletsNum { (static_cast<float>(firstLayerClustersNum) * secondLayerClustersNum)
+      * thirdLayerClustersNum };
+
+  if (clustersTripletsNum <= 0.f) {
+
+    return;
+  }
+
+  mCellsCoefficients[layerIndex] = addSample(mCellsSamples[layerIndex], mCellsNextSampleIndex[layerIndex],
+      mCellsSortedSamples[layerIndex], cellsNum / clustersTripletsNum);
+}
+
+float CapacityModel::addSample(std::vector<float>& samples, int& nextSampleIndex, std::vector<float>& sortedSamples,
+    const float sample) const
+{
+  const int samplesNum { std::max(1, mMemoryParameters.samplesNum) };
+
+  if (static_cast<int>(samples.size()) < samplesNum) {
+
+    samples.push_back(sample);
+
+  } else {
+
+    samples[nextSampleIndex] = sample;
+  }
+
+  nextSampleIndex = (nextSampleIndex + 1) % samplesNum;
+
+  sortedSamples.assign(samples.begin(), samples.end());
+  const float quantile { std::min(1.f, std::max(0.f, mMemoryParameters.occupancyQuantile)) };
+  const int quantileIndex { static_cast<int>(std::ceil(quantile * sortedSamples.size())) - 1 };
+  const auto quantileIterator = sortedSamples.begin() + std::max(0, quantileIndex);
+  std::nth_element(sortedSamples.begin(), quantileIterator, sortedSamples.end());
+
+  return *quantileIterator;
+}
+
+}
+}
+}
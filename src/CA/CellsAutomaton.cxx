@@ -0,0 +1,158 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file CellsAutomaton.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/CellsAutomaton.h"
+
+#include <future>
+
+#include "ITSReconstruction/CA/Cell.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+CellsAutomaton::CellsAutomaton()
+{
+  // Nothing to do
+}
+
+void CellsAutomaton::evolve(PrimaryVertexContext& primaryVertexContext, const bool parallelExecution)
+{
+  bool isEvolving { false };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    initializeLayer(primaryVertexContext, iLayer);
+    isEvolving |= iLayer > 0 && !primaryVertexContext.getCells()[iLayer].empty();
+  }
+
+  while (isEvolving) {
+
+    isEvolving = false;
+
+    if (parallelExecution) {
+
+      std::array<std::future<bool>, Constants::ITS::CellsPerRoad - 1> layersTasks;
+
+      for (int iLayer { 1 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+        layersTasks[iLayer - 1] = std::async(std::launch::async, [this, &primaryVertexContext, iLayer]() {
+          return evolveLayer(primaryVertexContext, iLayer);
+        });
+      }
+
+      for (int iLayer { 1 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+        isEvolving |= layersTasks[iLayer - 1].get();
+      }
+
+    } else {
+
+      for (int iLayer { 1 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+        isEvolving |= evolveLayer(primaryVertexContext, iLayer);
+      }
+    }
+
+    std::swap(mStates, mNextStates);
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    const int cellsNum { static_cast<int>(primaryVertexContext.getCells()[iLayer].size()) };
+
+    for (int iCell { 0 }; iCell < cellsNum; ++iCell) {
+
+      primaryVertexContext.getCells()[iLayer][iCell].setLevel(mStates[iLayer][iCell]);
+    }
+  }
+}
+
+void CellsAutomaton::initializeLayer(PrimaryVertexContext& primaryVertexContext, const int iLayer)
+{
+  const int cellsNum { static_cast<int>(primaryVertexContext.getCells()[iLayer].size()) };
+  const int wordsNum { (cellsNum + 63) / 64 };
+
+  mStates[iLayer].assign(cellsNum, 1);
+  mNextStates[iLayer].assign(cellsNum, 1);
+
+  /// The cells of the first layer and those without neighbours never evolve
+  if (iLayer == 0 || primaryVertexContext.getCellsNeighbours()[iLayer - 1].empty()) {
+
+    mAliveCells[iLayer].assign(wordsNum, 0);
+
+  } else {
+
+    mAliveCells[iLayer].assign(wordsNum, ~uint64_t { 0 });
+
+    if (cellsNum % 64 != 0) {
+
+      mAliveCells[iLayer].back() = (uint64_t { 1 } << (cellsNum % 64)) - 1;
+    }
+  }
+}
+
+bool CellsAutomaton::evolveLayer(PrimaryVertexContext& primaryVertexContext, const int iLayer)
+{
+  const std::vector<unsigned char>& currentStates { mStates[iLayer] };
+  const std::vector<unsigned char>& previousLayerStates { mStates[iLayer - 1] };
+  std::vector<unsigned char>& nextStates { mNextStates[iLayer] };
+  const int wordsNum { static_cast<int>(mAliveCells[iLayer].size()) };
+  bool isEvolving { false };
+
+  for (int iWord { 0 }; iWord < wordsNum; ++iWord) {
+
+    uint64_t aliveCells { mAliveCells[iLayer][iWord] };
+
+    while (aliveCells != 0) {
+
+      const int iCell { iWord * 64 + __builtin_ctzll(aliveCells) };
+      const uint64_t cellBit { aliveCells & (~aliveCells + 1) };
+      const std::vector<int>& cellNeighbours { primaryVertexContext.getCellsNeighbours()[iLayer - 1][iCell] };
+      const unsigned char currentState { currentStates[iCell] };
+      bool hasEqualNeighbour { false };
+
+      aliveCells ^= cellBit;
+
+      for (const int neighbourCellId : cellNeighbours) {
+
+        if (previousLayerStates[neighbourCellId] == currentState) {
+
+          hasEqualNeighbour = true;
+          break;
+        }
+      }
+
+      if (hasEqualNeighbour) {
+
+        nextStates[iCell] = currentState + 1;
+        isEvolving = true;
+
+      } else {
+
+        nextStates[iCell] = currentState;
+        mAliveCells[iLayer][iWord] ^= cellBit;
+      }
+    }
+  }
+
+  return isEvolving;
+}
+
+}
+}
+}
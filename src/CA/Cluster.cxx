@@ -25,9 +25,9 @@ namespace CA
 {
 
 Cluster::Cluster(const int clusterId, const int layerIndex, const float xCoordinate, const float yCoordinate,
-    const float zCoordinate, const float alphaAngle, const int monteCarloId)
+    const float zCoordinate, const float alphaAngle)
     : xCoordinate { xCoordinate }, yCoordinate { yCoordinate }, zCoordinate { zCoordinate }, phiCoordinate { 0 }, rCoordinate {
-        0 }, clusterId { clusterId }, alphaAngle { alphaAngle }, monteCarloId { monteCarloId }, indexTableBinIndex { 0 }
+        0 }, clusterId { clusterId }, alphaAngle { alphaAngle }, indexTableBinIndex { 0 }
 {
   // Nothing to do
 }
@@ -37,13 +37,22 @@ Cluster::Cluster(const int layerIndex, const float3 &primaryVertex, const Cluste
         MathUtils::getNormalizedPhiCoordinate(
             MathUtils::calculatePhiCoordinate(xCoordinate - primaryVertex.x, yCoordinate - primaryVertex.y)) }, rCoordinate {
         MathUtils::calculateRCoordinate(xCoordinate - primaryVertex.x, yCoordinate - primaryVertex.y) }, clusterId {
-        other.clusterId }, alphaAngle { other.alphaAngle }, monteCarloId { other.monteCarloId }, indexTableBinIndex {
+        other.clusterId }, alphaAngle { other.alphaAngle }, indexTableBinIndex {
         IndexTableUtils::getBinIndex(IndexTableUtils::getZBinIndex(layerIndex, zCoordinate),
             IndexTableUtils::getPhiBinIndex(phiCoordinate)) }
 {
   // Nothing to do
 }
 
+Cluster::Cluster(const Cluster& other, const float phiCoordinate, const float rCoordinate,
+    const int indexTableBinIndex)
+    : xCoordinate { other.xCoordinate }, yCoordinate { other.yCoordinate }, zCoordinate { other.zCoordinate }, phiCoordinate {
+        phiCoordinate }, rCoordinate { rCoordinate }, clusterId { other.clusterId }, alphaAngle { other.alphaAngle }, indexTableBinIndex {
+        indexTableBinIndex }
+{
+  // Nothing to do
+}
+
 }
 }
 }
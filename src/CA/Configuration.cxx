@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Configuration.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/Configuration.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Definitions.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+TrackingParameters::TrackingParameters()
+    : pipelinedExecution { false }, trackletsPruning { false }, cellsMinimumLevel {
+        Constants::Thresholds::CellsMinLevel }, montecarloLabels { true }, cellsAutomatonEvolution { false },
+        phiSectorsTraversal { false }, tracksFitting { false }, indexTableRegimesClustersNum { },
+        indexTableGranularities(1), indexTableSearchEngines(1)
+{
+  indexTableGranularities.front().fill(Constants::IndexTable::DefaultGranularity);
+  indexTableSearchEngines.front().fill(Constants::IndexTable::DefaultSearchEngine);
+}
+
+int TrackingParameters::getIndexTableRegime(const int clustersNum) const
+{
+  const int boundsNum { static_cast<int>(indexTableRegimesClustersNum.size()) };
+  int regimeIndex { 0 };
+
+  while (regimeIndex < boundsNum && clustersNum > indexTableRegimesClustersNum[regimeIndex]) {
+
+    ++regimeIndex;
+  }
+
+  return regimeIndex;
+}
+
+int TrackingParameters::getIndexTableGranularity(const int layerIndex, const int clustersNum) const
+{
+  const int regimesNum { static_cast<int>(indexTableGranularities.size()) };
+
+  if (regimesNum == 0) {
+
+    return Constants::IndexTable::DefaultGranularity;
+  }
+
+  return indexTableGranularities[std::min(regimesNum - 1, getIndexTableRegime(clustersNum))][layerIndex];
+}
+
+int TrackingParameters::getIndexTableSearchEngine(const int layerIndex, const int clustersNum) const
+{
+  const int regimesNum { static_cast<int>(indexTableSearchEngines.size()) };
+
+  if (regimesNum == 0) {
+
+    return Constants::IndexTable::DefaultSearchEngine;
+  }
+
+  return indexTableSearchEngines[std::min(regimesNum - 1, getIndexTableRegime(clustersNum))][layerIndex];
+}
+
+MemoryParameters::MemoryParameters()
+    : memoryMargin { 0.1f }, occupancyQuantile { 0.95f }, samplesNum { 100 }, hugePagesAllocation { false },
+        memoryBudget { 0 }, shrinkVerticesNum { 0 }, shrinkThreshold { 2.f }
+{
+  // Nothing to do
+}
+
+VertexingParameters::VertexingParameters()
+    : beamPosition { 0.f, 0.f }, phiCut { 0.01f }, zCut { 0.02f }, zRange { 15.f }, binSize { 0.02f }, peakWidth {
+        0.05f }, exclusionWidth { 0.15f }, minTrackletsNum { 10 }, minPeakSignificance { 5.f }, threadsNum { std::max(1, static_cast<int>(std::thread::hardware_concurrency())) }
+{
+  // Nothing to do
+}
+
+DecompositionParameters::DecompositionParameters()
+    : sectorsNum { 4 }, haloPhiWidth { Constants::Thresholds::PhiCoordinateCut
+        + Constants::Thresholds::CellMaxDeltaPhiThreshold }, slicesNum { 1 }, haloTanLambdaWidth {
+        Constants::ITS::CellsPerRoad * Constants::Thresholds::CellMaxDeltaTanLambdaThreshold }
+{
+  // Nothing to do
+}
+
+}
+}
+}
@@ -52,7 +52,14 @@ void Event::printPrimaryVertices() const
 void Event::pushClusterToLayer(const int layerIndex, const int clusterId, const float xCoordinate,
     const float yCoordinate, const float zCoordinate, const float aplhaAngle, const int monteCarlo)
 {
-  mLayers[layerIndex].addCluster(clusterId, xCoordinate, yCoordinate, zCoordinate, aplhaAngle, monteCarlo);
+  mLayers[layerIndex].addCluster(clusterId, xCoordinate, yCoordinate, zCoordinate, aplhaAngle);
+
+  if (clusterId >= static_cast<int>(mMonteCarloIds.size())) {
+
+    mMonteCarloIds.resize(clusterId + 1, Constants::ITS::UnusedIndex);
+  }
+
+  mMonteCarloIds[clusterId] = monteCarlo;
 }
 
 int Event::getTotalClusters() const
@@ -0,0 +1,151 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file HierarchicalGridLayer.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/HierarchicalGridLayer.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+constexpr int HierarchicalGridLayer::ZBins;
+constexpr int HierarchicalGridLayer::PhiBins;
+constexpr int HierarchicalGridLayer::RefinementFactor;
+constexpr int HierarchicalGridLayer::RefinementThreshold;
+constexpr int HierarchicalGridLayer::GhostPhiBins;
+constexpr int HierarchicalGridLayer::PaddedPhiBins;
+constexpr int HierarchicalGridLayer::FineZBins;
+constexpr int HierarchicalGridLayer::FinePhiBins;
+constexpr int HierarchicalGridLayer::FineBinsPerBin;
+
+HierarchicalGridLayer::HierarchicalGridLayer()
+    : layerIndex { 0 }, inverseFineZBinSize { 0.f }, inverseFinePhiBinSize { FinePhiBins / Constants::Math::TwoPi },
+        mFineIndexTable { }
+{
+  // Nothing to do
+}
+
+void HierarchicalGridLayer::initialize(const std::vector<Cluster>& clusters, const int clustersLayerIndex)
+{
+  const int clustersNum { static_cast<int>(clusters.size()) };
+
+  layerIndex = clustersLayerIndex;
+  inverseFineZBinSize = 0.5 * FineZBins / Constants::ITS::LayersZCoordinate()[layerIndex];
+  mPaddedClusterIndexes.clear();
+  mPaddedPhiCoordinates.clear();
+  mPaddedFineTableIndexes.clear();
+  mFineIndexTable.fill(0);
+
+  /// The clusters out of the layer acceptance go to the border bins, those of the first (last) GhostPhiBins phi bins
+  /// are duplicated in the ghost rows after (in front of) the layer
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    const Cluster& currentCluster { clusters[iCluster] };
+    const int fineZIndex { std::max(0, std::min(FineZBins - 1, getFineZBinIndex(currentCluster.zCoordinate))) };
+    const int finePhiIndex { std::max(0, std::min(FinePhiBins - 1, getFinePhiBinIndex(
+        currentCluster.phiCoordinate))) };
+
+    mPaddedClusterIndexes.push_back(iCluster);
+    mPaddedPhiCoordinates.push_back(currentCluster.phiCoordinate);
+    mPaddedFineTableIndexes.push_back(getFineTableIndex(fineZIndex, finePhiIndex));
+
+    if (finePhiIndex < GhostPhiBins * RefinementFactor) {
+
+      mPaddedClusterIndexes.push_back(iCluster);
+      mPaddedPhiCoordinates.push_back(currentCluster.phiCoordinate + Constants::Math::TwoPi);
+      mPaddedFineTableIndexes.push_back(getFineTableIndex(fineZIndex, finePhiIndex + FinePhiBins));
+
+    } else if (finePhiIndex >= FinePhiBins - GhostPhiBins * RefinementFactor) {
+
+      mPaddedClusterIndexes.push_back(iCluster);
+      mPaddedPhiCoordinates.push_back(currentCluster.phiCoordinate - Constants::Math::TwoPi);
+      mPaddedFineTableIndexes.push_back(getFineTableIndex(fineZIndex, finePhiIndex - FinePhiBins));
+    }
+  }
+
+  const int paddedClustersNum { static_cast<int>(mPaddedClusterIndexes.size()) };
+  const int fineBinsNum { ZBins * PaddedPhiBins * FineBinsPerBin };
+
+  for (int iPaddedCluster { 0 }; iPaddedCluster < paddedClustersNum; ++iPaddedCluster) {
+
+    ++mFineIndexTable[mPaddedFineTableIndexes[iPaddedCluster] + 1];
+  }
+
+  for (int iBin { 1 }; iBin <= fineBinsNum; ++iBin) {
+
+    mFineIndexTable[iBin] += mFineIndexTable[iBin - 1];
+  }
+
+  std::array<int, ZBins * PaddedPhiBins * FineBinsPerBin + 1> binsOffsets = mFineIndexTable;
+  mSortedPaddedIndexes.resize(paddedClustersNum);
+
+  for (int iPaddedCluster { 0 }; iPaddedCluster < paddedClustersNum; ++iPaddedCluster) {
+
+    mSortedPaddedIndexes[binsOffsets[mPaddedFineTableIndexes[iPaddedCluster]]++] = iPaddedCluster;
+  }
+
+  phiCoordinates.clear();
+  rCoordinates.clear();
+  zCoordinates.clear();
+  clusterIndexes.clear();
+
+  if (paddedClustersNum > static_cast<int>(clusterIndexes.capacity())) {
+
+    phiCoordinates.reserve(paddedClustersNum);
+    rCoordinates.reserve(paddedClustersNum);
+    zCoordinates.reserve(paddedClustersNum);
+    clusterIndexes.reserve(paddedClustersNum);
+  }
+
+  for (int iPaddedCluster { 0 }; iPaddedCluster < paddedClustersNum; ++iPaddedCluster) {
+
+    const int paddedIndex { mSortedPaddedIndexes[iPaddedCluster] };
+
+    addCluster(clusters[mPaddedClusterIndexes[paddedIndex]], mPaddedClusterIndexes[paddedIndex],
+        mPaddedPhiCoordinates[paddedIndex]);
+  }
+}
+
+std::size_t HierarchicalGridLayer::getMemorySize() const
+{
+  return (phiCoordinates.capacity() + rCoordinates.capacity() + zCoordinates.capacity()
+      + mPaddedPhiCoordinates.capacity()) * sizeof(float) + (clusterIndexes.capacity() + mPaddedClusterIndexes.capacity()
+      + mPaddedFineTableIndexes.capacity() + mSortedPaddedIndexes.capacity()) * sizeof(int);
+}
+
+void HierarchicalGridLayer::releaseMemory()
+{
+  phiCoordinates = std::vector<float> { };
+  rCoordinates = std::vector<float> { };
+  zCoordinates = std::vector<float> { };
+  clusterIndexes = std::vector<int> { };
+  mPaddedClusterIndexes = std::vector<int> { };
+  mPaddedPhiCoordinates = std::vector<float> { };
+  mPaddedFineTableIndexes = std::vector<int> { };
+  mSortedPaddedIndexes = std::vector<int> { };
+}
+
+void HierarchicalGridLayer::addCluster(const Cluster& cluster, const int clusterIndex, const float phiCoordinate)
+{
+  phiCoordinates.push_back(phiCoordinate);
+  rCoordinates.push_back(cluster.rCoordinate);
+  zCoordinates.push_back(cluster.zCoordinate);
+  clusterIndexes.push_back(clusterIndex);
+}
+
+}
+}
+}
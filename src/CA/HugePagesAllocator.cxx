@@ -0,0 +1,111 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file HugePagesAllocator.cxx
+/// \brief
+///
+
+
+#include "ITSReconstruction/CA/HugePagesAllocator.h"
+
+#include <cstdint>
+
+#if defined(__linux__)
+# include <sys/mman.h>
+#endif
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+namespace MemoryUtils
+{
+
+namespace
+{
+
+std::size_t getMappedBytes(const std::size_t bytes)
+{
+  const std::size_t hugePageSize { static_cast<std::size_t>(Constants::Memory::HugePageSize) };
+
+  return (bytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+}
+
+}
+
+void* allocateHugePages(const std::size_t bytes)
+{
+#if defined(__linux__)
+  const std::size_t mappedBytes { getMappedBytes(bytes) };
+  void* address { MAP_FAILED };
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  /// The page size is requested explicitly, the default huge page size of the system being possibly larger
+  address = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (Constants::Memory::HugePageShift << MAP_HUGE_SHIFT), -1, 0);
+
+  if (address != MAP_FAILED) {
+
+    return address;
+  }
+#endif
+
+  /// No explicit huge page left: map one huge page more than needed and unmap the head and the tail around the first
+  /// huge page boundary, so that the whole mapping can be backed by transparent huge pages
+  const std::size_t hugePageSize { static_cast<std::size_t>(Constants::Memory::HugePageSize) };
+  address = mmap(nullptr, mappedBytes + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (address == MAP_FAILED) {
+
+    throw std::bad_alloc();
+  }
+
+  const std::uintptr_t mappingBegin { reinterpret_cast<std::uintptr_t>(address) };
+  const std::uintptr_t alignedBegin { (mappingBegin + hugePageSize - 1) / hugePageSize * hugePageSize };
+  const std::uintptr_t alignedEnd { alignedBegin + mappedBytes };
+
+  if (alignedBegin > mappingBegin) {
+
+    munmap(address, alignedBegin - mappingBegin);
+  }
+
+  if (mappingBegin + mappedBytes + hugePageSize > alignedEnd) {
+
+    munmap(reinterpret_cast<void*>(alignedEnd), mappingBegin + mappedBytes + hugePageSize - alignedEnd);
+  }
+
+  /// A kernel without transparent huge pages refuses the advice and keeps the regular pages
+#if defined(MADV_HUGEPAGE)
+  madvise(reinterpret_cast<void*>(alignedBegin), mappedBytes, MADV_HUGEPAGE);
+#endif
+
+  return reinterpret_cast<void*>(alignedBegin);
+#else
+  return ::operator new(bytes);
+#endif
+}
+
+void deallocateHugePages(void* address, const std::size_t bytes)
+{
+#if defined(__linux__)
+  munmap(address, getMappedBytes(bytes));
+#else
+  ::operator delete(address);
+#endif
+}
+
+}
+
+}
+}
+}
@@ -50,7 +50,7 @@ std::vector<Event> IOUtils::loadEventData(const std::string& fileName)
 
     std::istringstream inputStringStream(line);
 
-    if (inputStringStream >> layerId >> xCoordinate >> yCoordinate >> zCoordinate) {
+    if (inputStringStream >> layerId) {
 
       if (layerId == PrimaryVertexLayerId) {
 
@@ -59,12 +59,18 @@ std::vector<Event> IOUtils::loadEventData(const std::string& fileName)
           events.emplace_back(events.size());
         }
 
-        events.back().addPrimaryVertex(xCoordinate, yCoordinate, zCoordinate);
+        /// A primary vertex line without coordinates starts an event whose vertices have to be found by the Vertexer
+        if (inputStringStream >> xCoordinate >> yCoordinate >> zCoordinate) {
+
+          events.back().addPrimaryVertex(xCoordinate, yCoordinate, zCoordinate);
+        }
+
         clusterId = 0;
 
       } else {
 
-        if (inputStringStream >> unusedVariable >> unusedVariable >> unusedVariable >> alphaAngle >> monteCarlo) {
+        if (inputStringStream >> xCoordinate >> yCoordinate >> zCoordinate >> unusedVariable >> unusedVariable
+            >> unusedVariable >> alphaAngle >> monteCarlo) {
 
           events.back().pushClusterToLayer(layerId, clusterId, xCoordinate, yCoordinate, zCoordinate, alphaAngle,
               monteCarlo);
@@ -0,0 +1,177 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file IndexTableTuner.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/IndexTableTuner.h"
+
+#include <chrono>
+#include <iomanip>
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+constexpr int IndexTableTuner::ConfigurationsNumber;
+
+IndexTableTuner::IndexTableTuner()
+    : mRegimesClustersNum { Constants::IndexTable::TuningRegimesClustersNum.begin(),
+        Constants::IndexTable::TuningRegimesClustersNum.end() }
+{
+  // Nothing to do
+}
+
+IndexTableTuner::IndexTableTuner(const std::vector<int>& regimesClustersNum)
+    : mRegimesClustersNum { regimesClustersNum }
+{
+  // Nothing to do
+}
+
+void IndexTableTuner::tune(const std::vector<Event>& events, TrackingParameters& trackingParameters)
+{
+  const int regimesNum { static_cast<int>(mRegimesClustersNum.size()) + 1 };
+  const int eventsNum { static_cast<int>(events.size()) };
+  const int defaultConfiguration { getConfigurationIndex(Constants::IndexTable::DefaultSearchEngine,
+      Constants::IndexTable::DefaultGranularity) };
+  trackingParameters.indexTableRegimesClustersNum = mRegimesClustersNum;
+
+  mRegimesTimes.assign(regimesNum, LayersTimes { });
+  mRegimesSamplesNum.assign(regimesNum, std::array<int, Constants::ITS::TrackletsPerRoad> { });
+  mRegimesConfigurations.assign(regimesNum, std::array<int, Constants::ITS::TrackletsPerRoad> { });
+
+  for (int iEvent { 0 }; iEvent < eventsNum; ++iEvent) {
+
+    const Event& currentEvent { events[iEvent] };
+    const int verticesNum { currentEvent.getPrimaryVerticesNum() };
+
+    for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+
+      for (int iConfiguration { 0 }; iConfiguration < ConfigurationsNumber; ++iConfiguration) {
+
+        mPrimaryVertexContext.getIndexTableSearchEngines().fill(getConfigurationSearchEngine(iConfiguration));
+        mPrimaryVertexContext.getIndexTableGranularities().fill(getConfigurationGranularity(iConfiguration));
+        mPrimaryVertexContext.initialize(currentEvent, iVertex);
+
+        for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+          const int regimeIndex { trackingParameters.getIndexTableRegime(
+              currentEvent.getLayer(iLayer + 1).getClustersSize()) };
+          const std::chrono::time_point<std::chrono::steady_clock> start { std::chrono::steady_clock::now() };
+
+          computeLayerTracklets(mPrimaryVertexContext, iLayer);
+
+          mRegimesTimes[regimeIndex][iLayer][iConfiguration] += std::chrono::duration<double, std::milli> {
+              std::chrono::steady_clock::now() - start }.count();
+
+          if (iConfiguration == 0) {
+
+            ++mRegimesSamplesNum[regimeIndex][iLayer];
+          }
+        }
+      }
+    }
+  }
+
+  trackingParameters.indexTableGranularities.resize(regimesNum);
+  trackingParameters.indexTableSearchEngines.resize(regimesNum);
+
+  for (int iRegime { 0 }; iRegime < regimesNum; ++iRegime) {
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+      int selectedConfiguration { defaultConfiguration };
+
+      if (mRegimesSamplesNum[iRegime][iLayer] > 0) {
+
+        for (int iConfiguration { 0 }; iConfiguration < ConfigurationsNumber; ++iConfiguration) {
+
+          if (mRegimesTimes[iRegime][iLayer][iConfiguration]
+              < mRegimesTimes[iRegime][iLayer][selectedConfiguration]) {
+
+            selectedConfiguration = iConfiguration;
+          }
+        }
+      }
+
+      mRegimesConfigurations[iRegime][iLayer] = selectedConfiguration;
+      trackingParameters.indexTableGranularities[iRegime][iLayer] = getConfigurationGranularity(
+          selectedConfiguration);
+      trackingParameters.indexTableSearchEngines[iRegime][iLayer] = getConfigurationSearchEngine(
+          selectedConfiguration);
+    }
+  }
+}
+
+void IndexTableTuner::printReport(std::ostream& outputStream) const
+{
+  const int regimesNum { static_cast<int>(mRegimesTimes.size()) };
+
+  for (int iRegime { 0 }; iRegime < regimesNum; ++iRegime) {
+
+    outputStream << "Regime " << iRegime;
+
+    if (iRegime < static_cast<int>(mRegimesClustersNum.size())) {
+
+      outputStream << " (clusters <= " << mRegimesClustersNum[iRegime] << ")" << std::endl;
+
+    } else if (iRegime > 0) {
+
+      outputStream << " (clusters > " << mRegimesClustersNum[iRegime - 1] << ")" << std::endl;
+
+    } else {
+
+      outputStream << std::endl;
+    }
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+      outputStream << " - Layer " << iLayer + 1 << ":";
+
+      for (int iConfiguration { 0 }; iConfiguration < ConfigurationsNumber; ++iConfiguration) {
+
+        const double meanTime { mRegimesSamplesNum[iRegime][iLayer] > 0 ?
+            mRegimesTimes[iRegime][iLayer][iConfiguration] / mRegimesSamplesNum[iRegime][iLayer] : 0. };
+        outputStream << " " << std::setw(10) << meanTime << "ms";
+      }
+
+      outputStream << " -> search engine " << getConfigurationSearchEngine(mRegimesConfigurations[iRegime][iLayer])
+          << ", granularity " << getConfigurationGranularity(mRegimesConfigurations[iRegime][iLayer]) << std::endl;
+    }
+  }
+}
+
+int IndexTableTuner::getConfigurationSearchEngine(const int configurationIndex)
+{
+  return configurationIndex < Constants::IndexTable::GranularitiesNumber ? Constants::IndexTable::GridSearchEngine :
+      configurationIndex - Constants::IndexTable::GranularitiesNumber + 1;
+}
+
+int IndexTableTuner::getConfigurationGranularity(const int configurationIndex)
+{
+  return configurationIndex < Constants::IndexTable::GranularitiesNumber ? configurationIndex :
+      Constants::IndexTable::DefaultGranularity;
+}
+
+int IndexTableTuner::getConfigurationIndex(const int searchEngine, const int granularity)
+{
+  return searchEngine == Constants::IndexTable::GridSearchEngine ? granularity :
+      Constants::IndexTable::GranularitiesNumber + searchEngine - 1;
+}
+#endif
+
+}
+}
+}
@@ -0,0 +1,47 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file MathUtils.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/MathUtils.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+/// Same values as calculatePhiCoordinate. The loop has no branch and is vectorised
+void MathUtils::calculatePhiCoordinates(const float* xCoordinates, const float* yCoordinates, const float xOrigin,
+    const float yOrigin, float* phiCoordinates, const int clustersNum)
+{
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    phiCoordinates[iCluster] = MATH_MIN(
+        fastAtan2(yOrigin - yCoordinates[iCluster], xOrigin - xCoordinates[iCluster]) + Constants::Math::Pi,
+        Constants::Math::MaxPhiCoordinate);
+  }
+}
+
+void MathUtils::calculateRCoordinates(const float* xCoordinates, const float* yCoordinates, const float xOrigin,
+    const float yOrigin, float* rCoordinates, const int clustersNum)
+{
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    rCoordinates[iCluster] = calculateRCoordinate(xCoordinates[iCluster] - xOrigin, yCoordinates[iCluster] - yOrigin);
+  }
+}
+
+}
+}
+}
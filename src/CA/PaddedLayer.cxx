@@ -0,0 +1,250 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PaddedLayer.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/PaddedLayer.h"
+
+#include <algorithm>
+
+#include "ITSReconstruction/CA/MathUtils.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+template<int ZBinsNum, int PhiBinsNum>
+constexpr int PaddedLayer<ZBinsNum, PhiBinsNum>::ZBins;
+
+template<int ZBinsNum, int PhiBinsNum>
+constexpr int PaddedLayer<ZBinsNum, PhiBinsNum>::PhiBins;
+
+template<int ZBinsNum, int PhiBinsNum>
+constexpr int PaddedLayer<ZBinsNum, PhiBinsNum>::GhostPhiBins;
+
+template<int ZBinsNum, int PhiBinsNum>
+constexpr int PaddedLayer<ZBinsNum, PhiBinsNum>::PaddedPhiBins;
+
+template<int ZBinsNum, int PhiBinsNum>
+constexpr int PaddedLayer<ZBinsNum, PhiBinsNum>::RowBitmapWords;
+
+template<int ZBinsNum, int PhiBinsNum>
+PaddedLayer<ZBinsNum, PhiBinsNum>::PaddedLayer()
+    : layerIndex { 0 }, inverseZBinSize { 0.f }, inversePhiBinSize { PhiBinsNum / Constants::Math::TwoPi },
+        compactIndexes { false }, occupancyBitmap { }, mIndexTable { }, mCompactIndexTable { }
+{
+  // Nothing to do
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+void PaddedLayer<ZBinsNum, PhiBinsNum>::initialize(const std::vector<Cluster>& clusters, const int clustersLayerIndex)
+{
+  const int clustersNum { static_cast<int>(clusters.size()) };
+  std::array<int, ZBinsNum * PhiBinsNum + 1> clustersIndexTable { };
+
+  layerIndex = clustersLayerIndex;
+  inverseZBinSize = 0.5 * ZBinsNum / Constants::ITS::LayersZCoordinate()[layerIndex];
+
+  /// Counting sort of the clusters by bin, the clusters out of the layer acceptance go to the border bins
+  mClustersBinIndexes.resize(clustersNum);
+  mSortedClusterIndexes.resize(clustersNum);
+
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    const int zBinIndex { std::max(0, std::min(ZBinsNum - 1, getZBinIndex(clusters[iCluster].zCoordinate))) };
+    const int phiBinIndex { std::max(0, std::min(PhiBinsNum - 1, getPhiBinIndex(clusters[iCluster].phiCoordinate))) };
+
+    mClustersBinIndexes[iCluster] = phiBinIndex * ZBinsNum + zBinIndex;
+    ++clustersIndexTable[mClustersBinIndexes[iCluster] + 1];
+  }
+
+  for (int iBin { 1 }; iBin <= ZBinsNum * PhiBinsNum; ++iBin) {
+
+    clustersIndexTable[iBin] += clustersIndexTable[iBin - 1];
+  }
+
+  std::array<int, ZBinsNum * PhiBinsNum + 1> binsOffsets = clustersIndexTable;
+
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    mSortedClusterIndexes[binsOffsets[mClustersBinIndexes[iCluster]]++] = iCluster;
+  }
+
+  const int firstLowerGhostIndex { clustersIndexTable[(PhiBinsNum - GhostPhiBins) * ZBinsNum] };
+  const int upperGhostsNum { clustersIndexTable[GhostPhiBins * ZBinsNum] };
+  const int lowerGhostsNum { clustersNum - firstLowerGhostIndex };
+  const int paddedClustersNum { lowerGhostsNum + clustersNum + upperGhostsNum };
+
+  /// Both the padded cluster offsets of the table and the layer cluster indexes are below the padded clusters number
+  compactIndexes = paddedClustersNum <= std::numeric_limits<uint16_t>::max();
+
+  phiCoordinates.clear();
+  rCoordinates.clear();
+  zCoordinates.clear();
+  mClusterIndexes.clear();
+  mCompactClusterIndexes.clear();
+
+  if (paddedClustersNum > static_cast<int>(phiCoordinates.capacity())) {
+
+    phiCoordinates.reserve(paddedClustersNum);
+    rCoordinates.reserve(paddedClustersNum);
+    zCoordinates.reserve(paddedClustersNum);
+  }
+
+  if (compactIndexes) {
+
+    mCompactClusterIndexes.reserve(paddedClustersNum);
+
+  } else {
+
+    mClusterIndexes.reserve(paddedClustersNum);
+  }
+
+  for (int iCluster { firstLowerGhostIndex }; iCluster < clustersNum; ++iCluster) {
+
+    addCluster(clusters[mSortedClusterIndexes[iCluster]], mSortedClusterIndexes[iCluster], -Constants::Math::TwoPi);
+  }
+
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    addCluster(clusters[mSortedClusterIndexes[iCluster]], mSortedClusterIndexes[iCluster], 0.f);
+  }
+
+  for (int iCluster { 0 }; iCluster < upperGhostsNum; ++iCluster) {
+
+    addCluster(clusters[mSortedClusterIndexes[iCluster]], mSortedClusterIndexes[iCluster], Constants::Math::TwoPi);
+  }
+
+  occupancyBitmap.fill(0);
+
+  /// The occupancy bitmap is filled along with the table, from the bins counts of the counting sort
+  for (int iPhiBin { -GhostPhiBins }; iPhiBin < PhiBinsNum + GhostPhiBins; ++iPhiBin) {
+
+    const int rowFirstWordIndex { (iPhiBin + GhostPhiBins) * RowBitmapWords };
+    int sourceBinIndex { };
+    int paddedClusterOffset { };
+
+    if (iPhiBin < 0) {
+
+      sourceBinIndex = (iPhiBin + PhiBinsNum) * ZBinsNum;
+      paddedClusterOffset = -firstLowerGhostIndex;
+
+    } else if (iPhiBin < PhiBinsNum) {
+
+      sourceBinIndex = iPhiBin * ZBinsNum;
+      paddedClusterOffset = lowerGhostsNum;
+
+    } else {
+
+      sourceBinIndex = (iPhiBin - PhiBinsNum) * ZBinsNum;
+      paddedClusterOffset = lowerGhostsNum + clustersNum;
+    }
+
+    for (int iZBin { 0 }; iZBin < ZBinsNum; ++iZBin, ++sourceBinIndex) {
+
+      setBinFirstClusterIndex(getPaddedBinIndex(iZBin, iPhiBin), clustersIndexTable[sourceBinIndex]
+          + paddedClusterOffset);
+
+      if (clustersIndexTable[sourceBinIndex + 1] > clustersIndexTable[sourceBinIndex]) {
+
+        occupancyBitmap[rowFirstWordIndex + iZBin / 64] |= uint64_t { 1 } << (iZBin % 64);
+      }
+    }
+  }
+
+  setBinFirstClusterIndex(ZBinsNum * PaddedPhiBins, paddedClustersNum);
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+int4 PaddedLayer<ZBinsNum, PhiBinsNum>::getBinsRect(const Cluster& currentCluster,
+    const float directionZIntersection) const
+{
+  const float zRangeMin = directionZIntersection - 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMin = currentCluster.phiCoordinate - Constants::Thresholds::PhiCoordinateCut;
+  const float zRangeMax = directionZIntersection + 2 * Constants::Thresholds::ZCoordinateCut;
+  const float phiRangeMax = currentCluster.phiCoordinate + Constants::Thresholds::PhiCoordinateCut;
+
+  if (zRangeMax < -Constants::ITS::LayersZCoordinate()[layerIndex]
+      || zRangeMin > Constants::ITS::LayersZCoordinate()[layerIndex] || zRangeMin > zRangeMax) {
+
+    return int4 { 0, 0, -1, -1 };
+  }
+
+  int4 binsRect { std::max(0, getZBinIndex(zRangeMin)), getPhiBinIndex(
+      MathUtils::getNormalizedPhiCoordinate(phiRangeMin)), std::min(ZBinsNum - 1, getZBinIndex(zRangeMax)),
+      getPhiBinIndex(MathUtils::getNormalizedPhiCoordinate(phiRangeMax)) };
+
+  /// A window crossing phi = 0 continues into the ghost rows on the side of the current cluster
+  if (binsRect.w < binsRect.y) {
+
+    if (currentCluster.phiCoordinate < Constants::Math::Pi) {
+
+      binsRect.y -= PhiBinsNum;
+
+    } else {
+
+      binsRect.w += PhiBinsNum;
+    }
+  }
+
+  return binsRect;
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+std::size_t PaddedLayer<ZBinsNum, PhiBinsNum>::getMemorySize() const
+{
+  return (phiCoordinates.capacity() + rCoordinates.capacity() + zCoordinates.capacity()) * sizeof(float)
+      + (mClusterIndexes.capacity() + mClustersBinIndexes.capacity() + mSortedClusterIndexes.capacity()) * sizeof(int)
+      + mCompactClusterIndexes.capacity() * sizeof(uint16_t);
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+void PaddedLayer<ZBinsNum, PhiBinsNum>::releaseMemory()
+{
+  phiCoordinates = std::vector<float> { };
+  rCoordinates = std::vector<float> { };
+  zCoordinates = std::vector<float> { };
+  mClusterIndexes = std::vector<int> { };
+  mCompactClusterIndexes = std::vector<uint16_t> { };
+  mClustersBinIndexes = std::vector<int> { };
+  mSortedClusterIndexes = std::vector<int> { };
+}
+
+template<int ZBinsNum, int PhiBinsNum>
+void PaddedLayer<ZBinsNum, PhiBinsNum>::addCluster(const Cluster& cluster, const int clusterIndex,
+    const float phiShift)
+{
+  phiCoordinates.push_back(cluster.phiCoordinate + phiShift);
+  rCoordinates.push_back(cluster.rCoordinate);
+  zCoordinates.push_back(cluster.zCoordinate);
+
+  if (compactIndexes) {
+
+    mCompactClusterIndexes.push_back(clusterIndex);
+
+  } else {
+
+    mClusterIndexes.push_back(clusterIndex);
+  }
+}
+
+template struct PaddedLayer<10, 10>;
+template struct PaddedLayer<Constants::IndexTable::ZBins, Constants::IndexTable::PhiBins>;
+template struct PaddedLayer<40, 40>;
+template struct PaddedLayer<80, 80>;
+
+}
+}
+}
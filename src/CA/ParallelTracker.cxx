@@ -0,0 +1,290 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ParallelTracker.cxx
+/// \brief
+///
+
+
+#include "ITSReconstruction/CA/ParallelTracker.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+namespace
+{
+
+/// Parses a kernel list of ranges, e.g. "0-3,8,10-11"
+std::vector<int> parseRangesList(const std::string& rangesList)
+{
+  std::vector<int> values { };
+  std::istringstream rangesStream { rangesList };
+  std::string range { };
+
+  while (std::getline(rangesStream, range, ',')) {
+
+    const size_t separatorPosition { range.find('-') };
+
+    if (range.empty() || range[0] < '0' || range[0] > '9') {
+
+      continue;
+    }
+
+    const int firstValue { std::stoi(range.substr(0, separatorPosition)) };
+    const int lastValue { separatorPosition == std::string::npos ? firstValue : std::stoi(
+        range.substr(separatorPosition + 1)) };
+
+    for (int value { firstValue }; value <= lastValue; ++value) {
+
+      values.push_back(value);
+    }
+  }
+
+  return values;
+}
+
+std::string readFirstLine(const std::string& fileName)
+{
+  std::ifstream fileStream { fileName };
+  std::string line { };
+  std::getline(fileStream, line);
+
+  return line;
+}
+
+/// Cpus of each online NUMA node the process may run on. Without NUMA information, all the usable cpus form one node
+std::vector<std::vector<int>> readNodesCpus()
+{
+  std::vector<int> usableCpus { };
+  std::vector<std::vector<int>> nodesCpus { };
+
+#if defined(__linux__)
+  cpu_set_t processCpus;
+  CPU_ZERO(&processCpus);
+
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &processCpus) == 0) {
+
+    for (int iCpu { 0 }; iCpu < CPU_SETSIZE; ++iCpu) {
+
+      if (CPU_ISSET(iCpu, &processCpus)) {
+
+        usableCpus.push_back(iCpu);
+      }
+    }
+  }
+
+  for (const int nodeIndex : parseRangesList(readFirstLine("/sys/devices/system/node/online"))) {
+
+    std::vector<int> nodeCpus { };
+
+    for (const int cpuIndex : parseRangesList(
+        readFirstLine("/sys/devices/system/node/node" + std::to_string(nodeIndex) + "/cpulist"))) {
+
+      if (std::find(usableCpus.begin(), usableCpus.end(), cpuIndex) != usableCpus.end()) {
+
+        nodeCpus.push_back(cpuIndex);
+      }
+    }
+
+    if (!nodeCpus.empty()) {
+
+      nodesCpus.push_back(nodeCpus);
+    }
+  }
+#endif
+
+  if (nodesCpus.empty()) {
+
+    if (usableCpus.empty()) {
+
+      for (int iCpu { 0 }; iCpu < std::max(1, static_cast<int>(std::thread::hardware_concurrency())); ++iCpu) {
+
+        usableCpus.push_back(iCpu);
+      }
+    }
+
+    nodesCpus.push_back(usableCpus);
+  }
+
+  return nodesCpus;
+}
+
+void pinCurrentThread(const int cpuIndex)
+{
+#if defined(__linux__)
+  cpu_set_t threadCpus;
+  CPU_ZERO(&threadCpus);
+  CPU_SET(cpuIndex, &threadCpus);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &threadCpus);
+#endif
+}
+
+}
+
+ParallelTracker::ParallelTracker()
+    : ParallelTracker(TrackingParameters { })
+{
+  // Nothing to do
+}
+
+ParallelTracker::ParallelTracker(const TrackingParameters& trackingParameters)
+    : mTrackingParameters { trackingParameters }, mNodesCpus { readNodesCpus() }
+{
+  int cpusNum { 0 };
+
+  for (const std::vector<int>& nodeCpus : mNodesCpus) {
+
+    cpusNum += nodeCpus.size();
+  }
+
+  placeWorkers(cpusNum);
+}
+
+ParallelTracker::ParallelTracker(const TrackingParameters& trackingParameters, const int workersNum)
+    : mTrackingParameters { trackingParameters }, mNodesCpus { readNodesCpus() }
+{
+  placeWorkers(std::max(1, workersNum));
+}
+
+void ParallelTracker::placeWorkers(const int workersNum)
+{
+  /// The workers go to the nodes in turn and fill the cores of each node in order
+  const int nodesNum { static_cast<int>(mNodesCpus.size()) };
+
+  for (int iWorker { 0 }; iWorker < workersNum; ++iWorker) {
+
+    const int nodeIndex { iWorker % nodesNum };
+    const std::vector<int>& nodeCpus { mNodesCpus[nodeIndex] };
+
+    mWorkersNodes.push_back(nodeIndex);
+    mWorkersCpus.push_back(nodeCpus[(iWorker / nodesNum) % nodeCpus.size()]);
+  }
+
+  mWorkersTrackers.resize(workersNum);
+  mWorkersExceptions.resize(workersNum);
+  mNodesEvents.resize(nodesNum);
+  mNodesNextEvents.resize(nodesNum);
+}
+
+std::vector<std::vector<std::vector<Road>>> ParallelTracker::clustersToTracks(const std::vector<Event>& events)
+{
+  const int eventsNum { static_cast<int>(events.size()) };
+  const int workersNum { getWorkersNum() };
+  std::vector<std::vector<std::vector<Road>>> roads(eventsNum);
+  std::vector<std::thread> workersThreads { };
+
+  mTracks.assign(eventsNum, std::vector<std::vector<Track>> { });
+
+  for (int iNode { 0 }; iNode < getNodesNum(); ++iNode) {
+
+    mNodesEvents[iNode].clear();
+    mNodesNextEvents[iNode] = 0;
+  }
+
+  for (int iEvent { 0 }; iEvent < eventsNum; ++iEvent) {
+
+    mNodesEvents[mWorkersNodes[iEvent % workersNum]].push_back(iEvent);
+  }
+
+  for (int iWorker { 0 }; iWorker < workersNum; ++iWorker) {
+
+    workersThreads.emplace_back(&ParallelTracker::runWorker, this, iWorker, std::cref(events), std::ref(roads));
+  }
+
+  for (std::thread& workerThread : workersThreads) {
+
+    workerThread.join();
+  }
+
+  for (std::exception_ptr& workerException : mWorkersExceptions) {
+
+    if (workerException) {
+
+      const std::exception_ptr rethrownException { workerException };
+      std::fill(mWorkersExceptions.begin(), mWorkersExceptions.end(), nullptr);
+      std::rethrow_exception(rethrownException);
+    }
+  }
+
+  return roads;
+}
+
+void ParallelTracker::runWorker(const int workerIndex, const std::vector<Event>& events,
+    std::vector<std::vector<std::vector<Road>>>& roads)
+{
+  const int nodeIndex { mWorkersNodes[workerIndex] };
+  pinCurrentThread(mWorkersCpus[workerIndex]);
+
+  try {
+
+    if (!mWorkersTrackers[workerIndex]) {
+
+      /// The pipelined stages would start their threads on the single core the worker is pinned to
+      TrackingParameters workerTrackingParameters { mTrackingParameters };
+      workerTrackingParameters.pipelinedExecution = false;
+      mWorkersTrackers[workerIndex].reset(new Tracker<false> { workerTrackingParameters });
+    }
+
+    trackNodeEvents(nodeIndex, *mWorkersTrackers[workerIndex], events, roads);
+
+  } catch (...) {
+
+    mWorkersExceptions[workerIndex] = std::current_exception();
+  }
+}
+
+void ParallelTracker::trackNodeEvents(const int nodeIndex, Tracker<false>& workerTracker,
+    const std::vector<Event>& events, std::vector<std::vector<std::vector<Road>>>& roads)
+{
+  while (true) {
+
+    int eventIndex { Constants::ITS::UnusedIndex };
+
+    {
+      std::lock_guard<std::mutex> nodeEventsLock { mNodesEventsMutex };
+
+      if (mNodesNextEvents[nodeIndex] < static_cast<int>(mNodesEvents[nodeIndex].size())) {
+
+        eventIndex = mNodesEvents[nodeIndex][mNodesNextEvents[nodeIndex]++];
+      }
+    }
+
+    if (eventIndex == Constants::ITS::UnusedIndex) {
+
+      break;
+    }
+
+    const Event nodeEvent { events[eventIndex] };
+    roads[eventIndex] = workerTracker.clustersToTracks(nodeEvent);
+    mTracks[eventIndex] = workerTracker.getTracks();
+  }
+}
+#endif
+
+}
+}
+}
@@ -0,0 +1,139 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file PhiSortedLayer.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/PhiSortedLayer.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+constexpr int PhiSortedLayer::BlockSize;
+
+PhiSortedLayer::PhiSortedLayer()
+    : layerIndex { 0 }
+{
+  // Nothing to do
+}
+
+void PhiSortedLayer::initialize(const std::vector<Cluster>& clusters, const int clustersLayerIndex)
+{
+  const int clustersNum { static_cast<int>(clusters.size()) };
+
+  layerIndex = clustersLayerIndex;
+  mPaddedClusterIndexes.clear();
+  mPaddedPhiCoordinates.clear();
+
+  for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+    const float phiCoordinate { clusters[iCluster].phiCoordinate };
+
+    mPaddedClusterIndexes.push_back(iCluster);
+    mPaddedPhiCoordinates.push_back(phiCoordinate);
+
+    if (phiCoordinate < Constants::Thresholds::PhiCoordinateCut) {
+
+      mPaddedClusterIndexes.push_back(iCluster);
+      mPaddedPhiCoordinates.push_back(phiCoordinate + Constants::Math::TwoPi);
+
+    } else if (phiCoordinate > Constants::Math::TwoPi - Constants::Thresholds::PhiCoordinateCut) {
+
+      mPaddedClusterIndexes.push_back(iCluster);
+      mPaddedPhiCoordinates.push_back(phiCoordinate - Constants::Math::TwoPi);
+    }
+  }
+
+  const int paddedClustersNum { static_cast<int>(mPaddedClusterIndexes.size()) };
+  const int blocksNum { (paddedClustersNum + BlockSize - 1) / BlockSize };
+
+  mSortedPaddedIndexes.resize(paddedClustersNum);
+
+  for (int iPaddedCluster { 0 }; iPaddedCluster < paddedClustersNum; ++iPaddedCluster) {
+
+    mSortedPaddedIndexes[iPaddedCluster] = iPaddedCluster;
+  }
+
+  std::sort(mSortedPaddedIndexes.begin(), mSortedPaddedIndexes.end(), [this](const int index1, const int index2) {
+    return mPaddedPhiCoordinates[index1] < mPaddedPhiCoordinates[index2];
+  });
+
+  mBlocksMaxPhiCoordinates.resize(blocksNum);
+
+  for (int iBlock { 0 }; iBlock < blocksNum; ++iBlock) {
+
+    const std::vector<int>::iterator blockBegin { mSortedPaddedIndexes.begin() + iBlock * BlockSize };
+    const std::vector<int>::iterator blockEnd { mSortedPaddedIndexes.begin()
+        + std::min(paddedClustersNum, (iBlock + 1) * BlockSize) };
+
+    mBlocksMaxPhiCoordinates[iBlock] = mPaddedPhiCoordinates[*(blockEnd - 1)];
+
+    std::sort(blockBegin, blockEnd, [&clusters, this](const int index1, const int index2) {
+      return clusters[mPaddedClusterIndexes[index1]].zCoordinate < clusters[mPaddedClusterIndexes[index2]].zCoordinate;
+    });
+  }
+
+  phiCoordinates.clear();
+  rCoordinates.clear();
+  zCoordinates.clear();
+  clusterIndexes.clear();
+
+  if (paddedClustersNum > static_cast<int>(clusterIndexes.capacity())) {
+
+    phiCoordinates.reserve(paddedClustersNum);
+    rCoordinates.reserve(paddedClustersNum);
+    zCoordinates.reserve(paddedClustersNum);
+    clusterIndexes.reserve(paddedClustersNum);
+  }
+
+  for (int iPaddedCluster { 0 }; iPaddedCluster < paddedClustersNum; ++iPaddedCluster) {
+
+    const int paddedIndex { mSortedPaddedIndexes[iPaddedCluster] };
+
+    addCluster(clusters[mPaddedClusterIndexes[paddedIndex]], mPaddedClusterIndexes[paddedIndex],
+        mPaddedPhiCoordinates[paddedIndex]);
+  }
+}
+
+std::size_t PhiSortedLayer::getMemorySize() const
+{
+  return (phiCoordinates.capacity() + rCoordinates.capacity() + zCoordinates.capacity()
+      + mPaddedPhiCoordinates.capacity() + mBlocksMaxPhiCoordinates.capacity()) * sizeof(float)
+      + (clusterIndexes.capacity() + mPaddedClusterIndexes.capacity() + mSortedPaddedIndexes.capacity()) * sizeof(int);
+}
+
+void PhiSortedLayer::releaseMemory()
+{
+  phiCoordinates = std::vector<float> { };
+  rCoordinates = std::vector<float> { };
+  zCoordinates = std::vector<float> { };
+  clusterIndexes = std::vector<int> { };
+  mPaddedClusterIndexes = std::vector<int> { };
+  mPaddedPhiCoordinates = std::vector<float> { };
+  mSortedPaddedIndexes = std::vector<int> { };
+  mBlocksMaxPhiCoordinates = std::vector<float> { };
+}
+
+void PhiSortedLayer::addCluster(const Cluster& cluster, const int clusterIndex, const float phiCoordinate)
+{
+  phiCoordinates.push_back(phiCoordinate);
+  rCoordinates.push_back(cluster.rCoordinate);
+  zCoordinates.push_back(cluster.zCoordinate);
+  clusterIndexes.push_back(clusterIndex);
+}
+
+}
+}
+}
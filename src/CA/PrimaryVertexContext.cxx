@@ -14,7 +14,11 @@
 
 #include "ITSReconstruction/CA/PrimaryVertexContext.h"
 
+#include <limits>
+
 #include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/IndexTableUtils.h"
+#include "ITSReconstruction/CA/MathUtils.h"
 
 namespace o2
 {
@@ -23,13 +27,112 @@ namespace ITS
 namespace CA
 {
 
+#if !TRACKINGITSU_GPU_MODE
+namespace
+{
+
+constexpr int UnlimitedCapacity { std::numeric_limits<int>::max() };
+constexpr std::size_t UnlimitedMemorySize { std::numeric_limits<std::size_t>::max() };
+
+/// Replaces the array with an empty one of the given capacity if it retains more than shrinkThreshold times it
+template<typename T, typename Allocator>
+void shrinkCapacity(std::vector<T, Allocator>& vector, const int capacity, const float shrinkThreshold)
+{
+  if (vector.capacity() > shrinkThreshold * capacity) {
+
+    std::vector<T, Allocator> shrunkVector { vector.get_allocator() };
+    shrunkVector.reserve(capacity);
+    vector.swap(shrunkVector);
+  }
+}
+
+/// Bytes of a tracklet and of a cell of a layer with the entries of the per-vertex arrays indexing them, as counted by
+/// getPredictedMemorySize
+std::size_t getTrackletMemorySize(const int layerIndex)
+{
+  return sizeof(Tracklet) + (layerIndex > 0 && layerIndex < Constants::ITS::CellsPerRoad ? sizeof(int) : 0);
+}
+
+std::size_t getCellMemorySize(const int layerIndex)
+{
+  return sizeof(Cell) + (layerIndex > 0 ? sizeof(std::vector<int>) + sizeof(int) : 0);
+}
+
+/// Initializes the padded layer of the dispatched granularity of a searched layer
+struct PaddedLayerInitializer final
+{
+    template<int Granularity>
+    void operator()(std::integral_constant<int, Granularity>) const
+    {
+      primaryVertexContext.getPaddedLayers<Granularity>()[iLayer - 1].initialize(
+          primaryVertexContext.getClusters()[iLayer], iLayer);
+    }
+
+    PrimaryVertexContext& primaryVertexContext;
+    const int iLayer;
+};
+
+/// Adds the bytes allocated by the padded layers of the dispatched granularity
+template<typename PaddedLayers>
+struct PaddedLayersMemorySizeCounter final
+{
+    template<int Granularity>
+    void operator()(std::integral_constant<int, Granularity>) const
+    {
+      for (const typename PaddedLayerGranularity<Granularity>::Type& paddedLayer : std::get<Granularity>(paddedLayers)) {
+
+        memorySize += paddedLayer.getMemorySize();
+      }
+    }
+
+    const PaddedLayers& paddedLayers;
+    std::size_t& memorySize;
+};
+
+/// Frees the padded layers of the dispatched granularity
+template<typename PaddedLayers>
+struct PaddedLayersReleaser final
+{
+    template<int Granularity>
+    void operator()(std::integral_constant<int, Granularity>) const
+    {
+      for (typename PaddedLayerGranularity<Granularity>::Type& paddedLayer : std::get<Granularity>(paddedLayers)) {
+
+        paddedLayer.releaseMemory();
+      }
+    }
+
+    PaddedLayers& paddedLayers;
+};
+
+}
+#endif
+
 PrimaryVertexContext::PrimaryVertexContext()
+    : mEvent { nullptr }
 {
-  // Nothing to do
+#if !TRACKINGITSU_GPU_MODE
+  mIndexTableSearchEngines.fill(Constants::IndexTable::DefaultSearchEngine);
+  mIndexTableGranularities.fill(Constants::IndexTable::DefaultGranularity);
+  mClustersHighWaterMarks.fill(0);
+  mTrackletsHighWaterMarks.fill(0);
+  mCellsHighWaterMarks.fill(0);
+  mShrinkVerticesCount = 0;
+  mTrackletsCapacityShares.fill(UnlimitedCapacity);
+  mCellsCapacityShares.fill(UnlimitedCapacity);
+  mArraysMemoryBudget = UnlimitedMemorySize;
+  mArraysMemorySize = 0;
+#endif
 }
 
 void PrimaryVertexContext::initialize(const Event& event, const int primaryVertexIndex) {
-  mPrimaryVertex = event.getPrimaryVertex(primaryVertexIndex);
+  initializeClusters(event, event.getPrimaryVertex(primaryVertexIndex));
+  initializeVertex(event.getPrimaryVertex(primaryVertexIndex));
+}
+
+void PrimaryVertexContext::initializeClusters(const Event& event, const float3& transverseOrigin)
+{
+  mEvent = &event;
 
   for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
 
@@ -43,43 +146,132 @@ void PrimaryVertexContext::initialize(const Event& event, const int primaryVerte
       mClusters[iLayer].reserve(clustersNum);
     }
 
+    mLayerXCoordinates.resize(clustersNum);
+    mLayerYCoordinates.resize(clustersNum);
+    mLayerZCoordinates.resize(clustersNum);
+    mLayerPhiCoordinates.resize(clustersNum);
+    mLayerRCoordinates.resize(clustersNum);
+    mLayerBinIndexes.resize(clustersNum);
+    mLayerSortedClusterIndexes.resize(clustersNum);
+
     for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
 
       const Cluster& currentCluster { currentLayer.getCluster(iCluster) };
-      mClusters[iLayer].emplace_back(iLayer, event.getPrimaryVertex(primaryVertexIndex), currentCluster);
+      mLayerXCoordinates[iCluster] = currentCluster.xCoordinate;
+      mLayerYCoordinates[iCluster] = currentCluster.yCoordinate;
+      mLayerZCoordinates[iCluster] = currentCluster.zCoordinate;
     }
 
-    std::sort(mClusters[iLayer].begin(), mClusters[iLayer].end(), [](Cluster& cluster1, Cluster& cluster2) {
-      return cluster1.indexTableBinIndex < cluster2.indexTableBinIndex;
-    });
+    MathUtils::calculatePhiCoordinates(mLayerXCoordinates.data(), mLayerYCoordinates.data(), transverseOrigin.x,
+        transverseOrigin.y, mLayerPhiCoordinates.data(), clustersNum);
+    MathUtils::calculateRCoordinates(mLayerXCoordinates.data(), mLayerYCoordinates.data(), transverseOrigin.x,
+        transverseOrigin.y, mLayerRCoordinates.data(), clustersNum);
 
-    if(iLayer < Constants::ITS::CellsPerRoad) {
+    /// The clusters out of the layer acceptance may have bins out of the table, the counting sort spans the bins
+    /// actually found
+    int minBinIndex { Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins };
+    int maxBinIndex { 0 };
 
-      mCells[iLayer].clear();
-      float cellsMemorySize = std::ceil(((Constants::Memory::CellsMemoryCoefficients[iLayer] * event.getLayer(iLayer).getClustersSize())
-         * event.getLayer(iLayer + 1).getClustersSize()) * event.getLayer(iLayer + 2).getClustersSize());
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
 
-      if(cellsMemorySize > mCells[iLayer].capacity()) {
+      const int binIndex { IndexTableUtils::getBinIndex(
+          IndexTableUtils::getZBinIndex(iLayer, mLayerZCoordinates[iCluster]),
+          IndexTableUtils::getPhiBinIndex(mLayerPhiCoordinates[iCluster])) };
 
-        mCells[iLayer].reserve(cellsMemorySize);
-      }
+      mLayerBinIndexes[iCluster] = binIndex;
+      minBinIndex = std::min(minBinIndex, binIndex);
+      maxBinIndex = std::max(maxBinIndex, binIndex);
     }
 
-    if(iLayer < Constants::ITS::CellsPerRoad - 1) {
+    mLayerBinsOffsets.assign(std::max(0, maxBinIndex - minBinIndex + 1), 0);
 
-      mCellsLookupTable[iLayer].clear();
-      mCellsLookupTable[iLayer].resize(std::ceil(
-        (Constants::Memory::TrackletsMemoryCoefficients[iLayer + 1] * event.getLayer(iLayer + 1).getClustersSize())
-          * event.getLayer(iLayer + 2).getClustersSize()), Constants::ITS::UnusedIndex);
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+      ++mLayerBinsOffsets[mLayerBinIndexes[iCluster] - minBinIndex];
+    }
 
+    int binOffset { 0 };
 
-      mCellsNeighbours[iLayer].clear();
+    for (int& binClustersNum : mLayerBinsOffsets) {
+
+      const int binFirstClusterIndex { binOffset };
+      binOffset += binClustersNum;
+      binClustersNum = binFirstClusterIndex;
+    }
+
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+      mLayerSortedClusterIndexes[mLayerBinsOffsets[mLayerBinIndexes[iCluster] - minBinIndex]++] = iCluster;
+    }
+
+    for (int iSortedCluster { 0 }; iSortedCluster < clustersNum; ++iSortedCluster) {
+
+      const int iCluster { mLayerSortedClusterIndexes[iSortedCluster] };
+
+      mClusters[iLayer].emplace_back(currentLayer.getCluster(iCluster), mLayerPhiCoordinates[iCluster],
+          mLayerRCoordinates[iCluster], mLayerBinIndexes[iCluster]);
     }
   }
 
-  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad - 1; ++iLayer) {
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 1 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    if (mIndexTableSearchEngines[iLayer - 1] == Constants::IndexTable::PhiSortedSearchEngine) {
+
+      mPhiSortedLayers[iLayer - 1].initialize(mClusters[iLayer], iLayer);
+      continue;
+    }
 
-    mCellsNeighbours[iLayer].clear();
+    if (mIndexTableSearchEngines[iLayer - 1] == Constants::IndexTable::HierarchicalGridSearchEngine) {
+
+      mHierarchicalGridLayers[iLayer - 1].initialize(mClusters[iLayer], iLayer);
+      continue;
+    }
+
+    dispatchGranularity(mIndexTableGranularities[iLayer - 1], PaddedLayerInitializer { *this, iLayer });
+  }
+#endif
+}
+
+void PrimaryVertexContext::initializeVertex(const float3& primaryVertex)
+{
+  mPrimaryVertex = primaryVertex;
+
+#if !TRACKINGITSU_GPU_MODE
+  updateHighWaterMarks();
+  applyShrinkPolicy();
+  mArraysMemorySize = getArraysMemorySize();
+#endif
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    mCells[iLayer].clear();
+    const int cellsMemorySize { mCapacityModel.getCellsCapacity(iLayer, mClusters[iLayer].size(),
+        mClusters[iLayer + 1].size(), mClusters[iLayer + 2].size()) };
+
+#if TRACKINGITSU_GPU_MODE
+    if(cellsMemorySize > static_cast<int>(mCells[iLayer].capacity())) {
+
+      mCells[iLayer].reserve(cellsMemorySize);
+    }
+#else
+    reserveCapacity(mCells[iLayer], std::min(cellsMemorySize, mCellsCapacityShares[iLayer]),
+        getCellMemorySize(iLayer));
+#endif
+
+#if !TRACKINGITSU_GPU_MODE
+    mCellsHighWaterMarks[iLayer] = std::max(mCellsHighWaterMarks[iLayer], cellsMemorySize);
+#endif
+
+    if(iLayer < Constants::ITS::CellsPerRoad - 1) {
+
+      mCellsLookupTable[iLayer].clear();
+#if TRACKINGITSU_GPU_MODE
+      mCellsLookupTable[iLayer].resize(mCapacityModel.getTrackletsCapacity(iLayer + 1, mClusters[iLayer + 1].size(),
+          mClusters[iLayer + 2].size()), Constants::ITS::UnusedIndex);
+#endif
+      mCellsNeighbours[iLayer].clear();
+    }
   }
 
   mRoads.clear();
@@ -89,58 +281,519 @@ void PrimaryVertexContext::initialize(const Event& event, const int primaryVerte
 #else
   for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
 
-    const int clustersNum = static_cast<int>(mClusters[iLayer].size());
+    mUsedClustersTable[iLayer].assign(mClusters[iLayer].size(), false);
 
-    if(iLayer > 0) {
+    if(iLayer < Constants::ITS::TrackletsPerRoad) {
 
-      int previousBinIndex { 0 };
-      mIndexTables[iLayer - 1][0] = 0;
+      mTracklets[iLayer].clear();
 
-      for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+      const int trackletsMemorySize { mCapacityModel.getTrackletsCapacity(iLayer, mClusters[iLayer].size(),
+          mClusters[iLayer + 1].size()) };
+      reserveCapacity(mTracklets[iLayer], std::min(trackletsMemorySize, mTrackletsCapacityShares[iLayer]),
+          getTrackletMemorySize(iLayer));
 
-        const int currentBinIndex { mClusters[iLayer][iCluster].indexTableBinIndex };
+      mTrackletsHighWaterMarks[iLayer] = std::max(mTrackletsHighWaterMarks[iLayer], trackletsMemorySize);
+    }
 
-        if (currentBinIndex > previousBinIndex) {
+    if(iLayer < Constants::ITS::CellsPerRoad) {
+
+      mTrackletsLookupTable[iLayer].clear();
+    }
+  }
+#endif
+}
 
-          for (int iBin { previousBinIndex + 1 }; iBin <= currentBinIndex; ++iBin) {
+void PrimaryVertexContext::initializeIteration()
+{
+#if !TRACKINGITSU_GPU_MODE
+  updateHighWaterMarks();
+#endif
 
-            mIndexTables[iLayer - 1][iBin] = iCluster;
-          }
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
-          previousBinIndex = currentBinIndex;
-        }
-      }
+    mCells[iLayer].clear();
 
-      for (int iBin { previousBinIndex + 1 }; iBin <= Constants::IndexTable::ZBins * Constants::IndexTable::PhiBins;
-          iBin++) {
+    if(iLayer < Constants::ITS::CellsPerRoad - 1) {
 
-        mIndexTables[iLayer - 1][iBin] = clustersNum;
-      }
+#if TRACKINGITSU_GPU_MODE
+      std::fill(mCellsLookupTable[iLayer].begin(), mCellsLookupTable[iLayer].end(), Constants::ITS::UnusedIndex);
+#else
+      mCellsLookupTable[iLayer].clear();
+#endif
+      mCellsNeighbours[iLayer].clear();
     }
+  }
 
-    if(iLayer < Constants::ITS::TrackletsPerRoad) {
+  mRoads.clear();
 
-      mTracklets[iLayer].clear();
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      float trackletsMemorySize = std::ceil((Constants::Memory::TrackletsMemoryCoefficients[iLayer] * event.getLayer(iLayer).getClustersSize())
-         * event.getLayer(iLayer + 1).getClustersSize());
+    mTracklets[iLayer].clear();
 
-      if(trackletsMemorySize > mTracklets[iLayer].capacity()) {
+    if(iLayer < Constants::ITS::CellsPerRoad) {
 
-        mTracklets[iLayer].reserve(trackletsMemorySize);
-      }
+      mTrackletsLookupTable[iLayer].clear();
     }
+  }
+#endif
+}
 
-    if(iLayer < Constants::ITS::CellsPerRoad) {
+void PrimaryVertexContext::setMemoryParameters(const MemoryParameters& memoryParameters)
+{
+  mCapacityModel.setMemoryParameters(memoryParameters);
 
-      mTrackletsLookupTable[iLayer].clear();
-      mTrackletsLookupTable[iLayer].resize(
-         event.getLayer(iLayer + 1).getClustersSize(), Constants::ITS::UnusedIndex);
+#if !TRACKINGITSU_GPU_MODE
+  const bool hugePagesAllocation { memoryParameters.hugePagesAllocation };
+
+  if (mTracklets[0].get_allocator().isHugePagesEnabled() == hugePagesAllocation) {
+
+    return;
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mTracklets[iLayer] = HugePagesVector<Tracklet> { HugePagesAllocator<Tracklet> { hugePagesAllocation } };
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      mCells[iLayer] = HugePagesVector<Cell> { HugePagesAllocator<Cell> { hugePagesAllocation } };
     }
   }
 #endif
 }
 
+void PrimaryVertexContext::sortCellsByLevel(const int layerIndex)
+{
+  /// Counting sort: the cells of level L are stored, in increasing index order, between the positions
+  /// mCellsLevelsLookupTable[layerIndex][L] and mCellsLevelsLookupTable[layerIndex][L + 1] of the layer indexes
+  std::array<int, Constants::ITS::CellsPerRoad + 2>& levelsLookupTable { mCellsLevelsLookupTable[layerIndex] };
+  std::vector<int>& levelsIndexes { mCellsLevelsIndexes[layerIndex] };
+  const int cellsNum { static_cast<int>(mCells[layerIndex].size()) };
+
+  levelsLookupTable.fill(0);
+
+  for (int iCell { 0 }; iCell < cellsNum; ++iCell) {
+
+    ++levelsLookupTable[mCells[layerIndex][iCell].getLevel() + 1];
+  }
+
+  for (int iLevel { 1 }; iLevel < Constants::ITS::CellsPerRoad + 2; ++iLevel) {
+
+    levelsLookupTable[iLevel] += levelsLookupTable[iLevel - 1];
+  }
+
+  std::array<int, Constants::ITS::CellsPerRoad + 2> levelsOffsets = levelsLookupTable;
+  levelsIndexes.resize(cellsNum);
+
+  for (int iCell { 0 }; iCell < cellsNum; ++iCell) {
+
+    levelsIndexes[levelsOffsets[mCells[layerIndex][iCell].getLevel()]++] = iCell;
+  }
+}
+
+#if !TRACKINGITSU_GPU_MODE
+void PrimaryVertexContext::buildTrackletsLookupTable(const int layerIndex)
+{
+  /// Exclusive scan of the tracklets per cluster: the tracklets of the layer layerIndex + 1 starting from the cluster C
+  /// are stored between the positions mTrackletsLookupTable[layerIndex][C] and mTrackletsLookupTable[layerIndex][C + 1]
+  std::vector<int>& lookupTable { mTrackletsLookupTable[layerIndex] };
+  const int clustersNum { static_cast<int>(mClusters[layerIndex + 1].size()) };
+
+  lookupTable.assign(clustersNum + 1, 0);
+
+  for (const Tracklet& tracklet : mTracklets[layerIndex + 1]) {
+
+    ++lookupTable[tracklet.firstClusterIndex + 1];
+  }
+
+  for (int iCluster { 1 }; iCluster <= clustersNum; ++iCluster) {
+
+    lookupTable[iCluster] += lookupTable[iCluster - 1];
+  }
+}
+
+void PrimaryVertexContext::buildCellsLookupTable(const int layerIndex)
+{
+  /// Exclusive scan of the cells per tracklet: the cells of the layer layerIndex + 1 starting from the tracklet T are
+  /// stored between the positions mCellsLookupTable[layerIndex][T] and mCellsLookupTable[layerIndex][T + 1]
+  std::vector<int>& lookupTable { mCellsLookupTable[layerIndex] };
+  const int trackletsNum { static_cast<int>(mTracklets[layerIndex + 1].size()) };
+
+  lookupTable.assign(trackletsNum + 1, 0);
+
+  for (const Cell& cell : mCells[layerIndex + 1]) {
+
+    ++lookupTable[cell.getFirstTrackletIndex() + 1];
+  }
+
+  for (int iTracklet { 1 }; iTracklet <= trackletsNum; ++iTracklet) {
+
+    lookupTable[iTracklet] += lookupTable[iTracklet - 1];
+  }
+}
+
+void PrimaryVertexContext::sampleTrackletsOccupancy(const int layerIndex)
+{
+  mCapacityModel.addTrackletsSample(layerIndex, mClusters[layerIndex].size(), mClusters[layerIndex + 1].size(),
+      mTracklets[layerIndex].size());
+}
+
+void PrimaryVertexContext::sampleCellsOccupancy(const int layerIndex)
+{
+  mCapacityModel.addCellsSample(layerIndex, mClusters[layerIndex].size(), mClusters[layerIndex + 1].size(),
+      mClusters[layerIndex + 2].size(), mCells[layerIndex].size());
+}
+
+std::size_t PrimaryVertexContext::getPredictedMemorySize(const Event& event) const
+{
+  std::array<int, Constants::ITS::TrackletsPerRoad> trackletsCapacities;
+  std::array<int, Constants::ITS::CellsPerRoad> cellsCapacities;
+  std::size_t memorySize { predictCapacities(event, trackletsCapacities, cellsCapacities) };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    memorySize += trackletsCapacities[iLayer] * getTrackletMemorySize(iLayer);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      memorySize += cellsCapacities[iLayer] * getCellMemorySize(iLayer);
+    }
+  }
+
+  return memorySize;
+}
+
+void PrimaryVertexContext::setMemoryBudget(const Event& event, const std::size_t memoryBudget)
+{
+  mTrackletsCapacityShares.fill(UnlimitedCapacity);
+  mCellsCapacityShares.fill(UnlimitedCapacity);
+  mArraysMemoryBudget = UnlimitedMemorySize;
+
+  if (memoryBudget == 0) {
+
+    return;
+  }
+
+  std::array<int, Constants::ITS::TrackletsPerRoad> trackletsCapacities;
+  std::array<int, Constants::ITS::CellsPerRoad> cellsCapacities;
+  const std::size_t clustersMemorySize { predictCapacities(event, trackletsCapacities, cellsCapacities) };
+  std::size_t arraysMemorySize { 0 };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    arraysMemorySize += trackletsCapacities[iLayer] * getTrackletMemorySize(iLayer);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      arraysMemorySize += cellsCapacities[iLayer] * getCellMemorySize(iLayer);
+    }
+  }
+
+  /// Every layer reserves the same fraction of its predicted capacity, any growth past it is then drawn from the
+  /// whole budget left by the clusters
+  const double capacityScale { memoryBudget > clustersMemorySize && arraysMemorySize > 0 ?
+      static_cast<double>(memoryBudget - clustersMemorySize) / arraysMemorySize : 0. };
+  mArraysMemoryBudget = memoryBudget > clustersMemorySize ? memoryBudget - clustersMemorySize : 0;
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mTrackletsCapacityShares[iLayer] = static_cast<int>(std::min<double>(UnlimitedCapacity - 1,
+        capacityScale * trackletsCapacities[iLayer]));
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      mCellsCapacityShares[iLayer] = static_cast<int>(std::min<double>(UnlimitedCapacity - 1,
+          capacityScale * cellsCapacities[iLayer]));
+    }
+  }
+
+  if (getArraysMemorySize() > mArraysMemoryBudget) {
+
+    releaseMemory();
+  }
+
+  mArraysMemorySize = getArraysMemorySize();
+}
+
+void PrimaryVertexContext::growTracklets(const int layerIndex)
+{
+  growCapacity(mTracklets[layerIndex], getTrackletMemorySize(layerIndex));
+}
+
+void PrimaryVertexContext::growCells(const int layerIndex)
+{
+  growCapacity(mCells[layerIndex], getCellMemorySize(layerIndex));
+}
+
+std::size_t PrimaryVertexContext::getMemorySize() const
+{
+  std::size_t memorySize { (mLayerXCoordinates.capacity() + mLayerYCoordinates.capacity()
+      + mLayerZCoordinates.capacity() + mLayerPhiCoordinates.capacity() + mLayerRCoordinates.capacity()) * sizeof(float)
+      + (mLayerBinIndexes.capacity() + mLayerBinsOffsets.capacity() + mLayerSortedClusterIndexes.capacity())
+          * sizeof(int) + mRoads.capacity() * sizeof(Road) };
+
+  for (int iGranularity { 0 }; iGranularity < Constants::IndexTable::GranularitiesNumber; ++iGranularity) {
+
+    dispatchGranularity(iGranularity,
+        PaddedLayersMemorySizeCounter<decltype(mPaddedLayers)> { mPaddedLayers, memorySize });
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    memorySize += mClusters[iLayer].capacity() * sizeof(Cluster);
+    memorySize += (mUsedClustersTable[iLayer].capacity() + 7) / 8;
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    memorySize += mPhiSortedLayers[iLayer].getMemorySize() + mHierarchicalGridLayers[iLayer].getMemorySize();
+
+    memorySize += mTracklets[iLayer].capacity() * sizeof(Tracklet);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      memorySize += mCells[iLayer].capacity() * sizeof(Cell);
+      memorySize += (mTrackletsLookupTable[iLayer].capacity() + mCellsLevelsIndexes[iLayer].capacity()) * sizeof(int);
+      memorySize += mIncomingTrackletsTable[iLayer].capacity() * sizeof(unsigned char);
+    }
+
+    if (iLayer < Constants::ITS::CellsPerRoad - 1) {
+
+      memorySize += mCellsLookupTable[iLayer].capacity() * sizeof(int);
+      memorySize += mCellsNeighbours[iLayer].capacity() * sizeof(std::vector<int>);
+
+      for (const std::vector<int>& cellNeighbours : mCellsNeighbours[iLayer]) {
+
+        memorySize += cellNeighbours.capacity() * sizeof(int);
+      }
+    }
+  }
+
+  return memorySize;
+}
+
+void PrimaryVertexContext::releaseMemory()
+{
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mTracklets[iLayer] = HugePagesVector<Tracklet> { mTracklets[iLayer].get_allocator() };
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      mCells[iLayer] = HugePagesVector<Cell> { mCells[iLayer].get_allocator() };
+      mTrackletsLookupTable[iLayer] = std::vector<int> { };
+    }
+
+    if (iLayer < Constants::ITS::CellsPerRoad - 1) {
+
+      mCellsLookupTable[iLayer] = std::vector<int> { };
+      mCellsNeighbours[iLayer] = std::vector<std::vector<int>> { };
+    }
+  }
+}
+
+void PrimaryVertexContext::releaseClustersMemory()
+{
+  for (int iGranularity { 0 }; iGranularity < Constants::IndexTable::GranularitiesNumber; ++iGranularity) {
+
+    dispatchGranularity(iGranularity, PaddedLayersReleaser<decltype(mPaddedLayers)> { mPaddedLayers });
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    mClusters[iLayer] = std::vector<Cluster> { };
+    mUsedClustersTable[iLayer] = std::vector<bool> { };
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mPhiSortedLayers[iLayer].releaseMemory();
+    mHierarchicalGridLayers[iLayer].releaseMemory();
+  }
+
+  mLayerXCoordinates = std::vector<float> { };
+  mLayerYCoordinates = std::vector<float> { };
+  mLayerZCoordinates = std::vector<float> { };
+  mLayerPhiCoordinates = std::vector<float> { };
+  mLayerRCoordinates = std::vector<float> { };
+  mLayerBinIndexes = std::vector<int> { };
+  mLayerBinsOffsets = std::vector<int> { };
+  mLayerSortedClusterIndexes = std::vector<int> { };
+}
+
+std::size_t PrimaryVertexContext::predictCapacities(const Event& event,
+    std::array<int, Constants::ITS::TrackletsPerRoad>& trackletsCapacities,
+    std::array<int, Constants::ITS::CellsPerRoad>& cellsCapacities) const
+{
+  std::array<int, Constants::ITS::LayersNumber> clustersNums;
+  std::size_t memorySize { 0 };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    clustersNums[iLayer] = static_cast<int>(event.getLayer(iLayer).getClusters().size());
+    memorySize += clustersNums[iLayer] * sizeof(Cluster) + (clustersNums[iLayer] + 7) / 8;
+
+    /// The search copy of a searched layer holds the coordinates and the indexes of its clusters
+    if (iLayer > 0) {
+
+      memorySize += clustersNums[iLayer] * (3 * sizeof(float) + 3 * sizeof(int));
+    }
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    trackletsCapacities[iLayer] = mCapacityModel.getTrackletsCapacity(iLayer, clustersNums[iLayer],
+        clustersNums[iLayer + 1]);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      cellsCapacities[iLayer] = mCapacityModel.getCellsCapacity(iLayer, clustersNums[iLayer], clustersNums[iLayer + 1],
+          clustersNums[iLayer + 2]);
+      memorySize += (clustersNums[iLayer + 1] + 1) * sizeof(int);
+    }
+
+    if (iLayer > 0 && iLayer < Constants::ITS::CellsPerRoad) {
+
+      memorySize += sizeof(int);
+    }
+  }
+
+  return memorySize;
+}
+
+std::size_t PrimaryVertexContext::getArraysMemorySize() const
+{
+  std::size_t memorySize { 0 };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    memorySize += mTracklets[iLayer].capacity() * getTrackletMemorySize(iLayer);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      memorySize += mCells[iLayer].capacity() * getCellMemorySize(iLayer);
+    }
+  }
+
+  return memorySize;
+}
+
+template<typename T, typename Allocator>
+bool PrimaryVertexContext::reserveCapacity(std::vector<T, Allocator>& vector, const std::size_t capacity,
+    const std::size_t elementMemorySize)
+{
+  const std::size_t currentCapacity { vector.capacity() };
+
+  if (capacity <= currentCapacity) {
+
+    return false;
+  }
+
+  if (mArraysMemoryBudget == UnlimitedMemorySize) {
+
+    vector.reserve(capacity);
+
+    return true;
+  }
+
+  /// The layers of the pipelined stages grow concurrently, each one takes its bytes from the shared budget
+  std::size_t arraysMemorySize { mArraysMemorySize.load() };
+  std::size_t reservedCapacity { };
+
+  do {
+
+    const std::size_t freeCapacity { mArraysMemoryBudget > arraysMemorySize ?
+        (mArraysMemoryBudget - arraysMemorySize) / elementMemorySize : 0 };
+    reservedCapacity = std::min(capacity, currentCapacity + freeCapacity);
+
+    if (reservedCapacity == currentCapacity) {
+
+      return false;
+    }
+
+  } while (!mArraysMemorySize.compare_exchange_weak(arraysMemorySize,
+      arraysMemorySize + (reservedCapacity - currentCapacity) * elementMemorySize));
+
+  vector.reserve(reservedCapacity);
+
+  return true;
+}
+
+template<typename T, typename Allocator>
+void PrimaryVertexContext::growCapacity(std::vector<T, Allocator>& vector, const std::size_t elementMemorySize)
+{
+  if (mArraysMemoryBudget == UnlimitedMemorySize || vector.size() < vector.capacity()) {
+
+    return;
+  }
+
+  if (!reserveCapacity(vector, std::max<std::size_t>(1, 2 * vector.capacity()), elementMemorySize)) {
+
+    throw MemoryBudgetExceeded { };
+  }
+}
+
+void PrimaryVertexContext::updateHighWaterMarks()
+{
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    mClustersHighWaterMarks[iLayer] = std::max(mClustersHighWaterMarks[iLayer],
+        static_cast<int>(mClusters[iLayer].size()));
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    mTrackletsHighWaterMarks[iLayer] = std::max(mTrackletsHighWaterMarks[iLayer],
+        static_cast<int>(mTracklets[iLayer].size()));
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      mCellsHighWaterMarks[iLayer] = std::max(mCellsHighWaterMarks[iLayer], static_cast<int>(mCells[iLayer].size()));
+    }
+  }
+}
+
+void PrimaryVertexContext::applyShrinkPolicy()
+{
+  /// Hysteresis: the arrays grow as soon as a vertex needs it, but are shrunk only once every shrinkVerticesNum
+  /// vertices and only if the largest need of those vertices left most of their capacity unused. The arrays are
+  /// emptied by initializeVertex anyway
+  const MemoryParameters& memoryParameters { mCapacityModel.getMemoryParameters() };
+
+  if (memoryParameters.shrinkVerticesNum <= 0 || ++mShrinkVerticesCount < memoryParameters.shrinkVerticesNum) {
+
+    return;
+  }
+
+  const float shrinkThreshold { std::max(1.f, memoryParameters.shrinkThreshold) };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    shrinkCapacity(mTracklets[iLayer], mTrackletsHighWaterMarks[iLayer], shrinkThreshold);
+
+    if (iLayer < Constants::ITS::CellsPerRoad) {
+
+      shrinkCapacity(mCells[iLayer], mCellsHighWaterMarks[iLayer], shrinkThreshold);
+      shrinkCapacity(mCellsLevelsIndexes[iLayer], mCellsHighWaterMarks[iLayer], shrinkThreshold);
+      shrinkCapacity(mTrackletsLookupTable[iLayer], mClustersHighWaterMarks[iLayer + 1] + 1, shrinkThreshold);
+      shrinkCapacity(mIncomingTrackletsTable[iLayer], mClustersHighWaterMarks[iLayer + 1], shrinkThreshold);
+    }
+
+    if (iLayer < Constants::ITS::CellsPerRoad - 1) {
+
+      shrinkCapacity(mCellsLookupTable[iLayer], mTrackletsHighWaterMarks[iLayer + 1] + 1, shrinkThreshold);
+      shrinkCapacity(mCellsNeighbours[iLayer], mCellsHighWaterMarks[iLayer + 1], shrinkThreshold);
+    }
+  }
+
+  mClustersHighWaterMarks.fill(0);
+  mTrackletsHighWaterMarks.fill(0);
+  mCellsHighWaterMarks.fill(0);
+  mShrinkVerticesCount = 0;
+}
+#endif
+
 }
 }
 }
@@ -0,0 +1,473 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file SectorTracker.cxx
+/// \brief
+///
+
+
+#include "ITSReconstruction/CA/SectorTracker.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Tracker.h"
+#include "ITSReconstruction/CA/TrackingUtils.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+#if !TRACKINGITSU_GPU_MODE
+namespace
+{
+
+/// Layout of a cluster on the socket, in host memory representation as both ends run the same binary
+struct SectorCluster
+    final
+    {
+      int clusterId;
+      float xCoordinate;
+      float yCoordinate;
+      float zCoordinate;
+      float alphaAngle;
+      int monteCarloId;
+  };
+
+void sendBytes(const int socketDescriptor, const void* data, const size_t bytesNum)
+{
+  const char* bytes { static_cast<const char*>(data) };
+  size_t sentBytesNum { 0 };
+
+  while (sentBytesNum < bytesNum) {
+
+    const ssize_t result { ::send(socketDescriptor, bytes + sentBytesNum, bytesNum - sentBytesNum, MSG_NOSIGNAL) };
+
+    if (result < 0 && errno == EINTR) {
+
+      continue;
+    }
+
+    if (result <= 0) {
+
+      throw std::runtime_error { "Sector socket send failed" };
+    }
+
+    sentBytesNum += result;
+  }
+}
+
+void receiveBytes(const int socketDescriptor, void* data, const size_t bytesNum)
+{
+  char* bytes { static_cast<char*>(data) };
+  size_t receivedBytesNum { 0 };
+
+  while (receivedBytesNum < bytesNum) {
+
+    const ssize_t result { ::recv(socketDescriptor, bytes + receivedBytesNum, bytesNum - receivedBytesNum, 0) };
+
+    if (result < 0 && errno == EINTR) {
+
+      continue;
+    }
+
+    if (result <= 0) {
+
+      throw std::runtime_error { "Sector socket receive failed" };
+    }
+
+    receivedBytesNum += result;
+  }
+}
+
+template<typename T>
+void sendValue(const int socketDescriptor, const T& value)
+{
+  sendBytes(socketDescriptor, &value, sizeof(T));
+}
+
+template<typename T>
+T receiveValue(const int socketDescriptor)
+{
+  T value;
+  receiveBytes(socketDescriptor, &value, sizeof(T));
+
+  return value;
+}
+
+void sendEvent(const int socketDescriptor, const Event& event)
+{
+  const int verticesNum { event.getPrimaryVerticesNum() };
+  std::vector<SectorCluster> layerClusters { };
+
+  sendValue(socketDescriptor, event.getEventId());
+  sendValue(socketDescriptor, verticesNum);
+
+  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+
+    sendValue(socketDescriptor, event.getPrimaryVertex(iVertex));
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    layerClusters.clear();
+
+    for (const Cluster& cluster : event.getLayer(iLayer).getClusters()) {
+
+      layerClusters.push_back(SectorCluster { cluster.clusterId, cluster.xCoordinate, cluster.yCoordinate,
+          cluster.zCoordinate, cluster.alphaAngle, event.getMonteCarloId(cluster.clusterId) });
+    }
+
+    const int clustersNum { static_cast<int>(layerClusters.size()) };
+    sendValue(socketDescriptor, clustersNum);
+    sendBytes(socketDescriptor, layerClusters.data(), clustersNum * sizeof(SectorCluster));
+  }
+}
+
+Event receiveEvent(const int socketDescriptor)
+{
+  Event event { receiveValue<int>(socketDescriptor) };
+  const int verticesNum { receiveValue<int>(socketDescriptor) };
+  std::vector<SectorCluster> layerClusters { };
+
+  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+
+    const float3 primaryVertex { receiveValue<float3>(socketDescriptor) };
+    event.addPrimaryVertex(primaryVertex.x, primaryVertex.y, primaryVertex.z);
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    layerClusters.resize(receiveValue<int>(socketDescriptor));
+    receiveBytes(socketDescriptor, layerClusters.data(), layerClusters.size() * sizeof(SectorCluster));
+
+    for (const SectorCluster& cluster : layerClusters) {
+
+      event.pushClusterToLayer(iLayer, cluster.clusterId, cluster.xCoordinate, cluster.yCoordinate,
+          cluster.zCoordinate, cluster.alphaAngle, cluster.monteCarloId);
+    }
+  }
+
+  return event;
+}
+
+void sendTracks(const int socketDescriptor, const std::vector<std::vector<Track>>& tracks)
+{
+  sendValue(socketDescriptor, static_cast<int>(tracks.size()));
+
+  for (const std::vector<Track>& vertexTracks : tracks) {
+
+    sendValue(socketDescriptor, static_cast<int>(vertexTracks.size()));
+    sendBytes(socketDescriptor, vertexTracks.data(), vertexTracks.size() * sizeof(Track));
+  }
+}
+
+std::vector<std::vector<Track>> receiveTracks(const int socketDescriptor)
+{
+  std::vector<std::vector<Track>> tracks(receiveValue<int>(socketDescriptor));
+
+  for (std::vector<Track>& vertexTracks : tracks) {
+
+    vertexTracks.resize(receiveValue<int>(socketDescriptor));
+    receiveBytes(socketDescriptor, vertexTracks.data(), vertexTracks.size() * sizeof(Track));
+  }
+
+  return tracks;
+}
+
+/// A track found by a sector, with the keys the merge orders the copies of the same track by
+struct SectorTrack
+    final
+    {
+      const Track* track;
+      int sectorIndex;
+      int trackIndex;
+      int clustersNum;
+      int innermostLayer;
+      /// Whether the sector owns the innermost cluster of the track
+      bool isOwned;
+  };
+
+/// Closes the parent ends of the sectors sockets and waits for their processes. Returns false if any process failed
+bool joinSectors(std::vector<int>& socketDescriptors, std::vector<pid_t>& processIds)
+{
+  bool succeeded { true };
+
+  for (int& socketDescriptor : socketDescriptors) {
+
+    if (socketDescriptor >= 0) {
+
+      ::close(socketDescriptor);
+      socketDescriptor = -1;
+    }
+  }
+
+  for (pid_t& processId : processIds) {
+
+    int processStatus { 0 };
+
+    if (processId > 0) {
+
+      while (::waitpid(processId, &processStatus, 0) < 0 && errno == EINTR) {
+
+        continue;
+      }
+
+      succeeded = succeeded && WIFEXITED(processStatus) && WEXITSTATUS(processStatus) == EXIT_SUCCESS;
+      processId = -1;
+    }
+  }
+
+  return succeeded;
+}
+
+}
+
+SectorTracker::SectorTracker()
+{
+  // Nothing to do
+}
+
+SectorTracker::SectorTracker(const TrackingParameters& trackingParameters,
+    const DecompositionParameters& decompositionParameters)
+    : mTrackingParameters { trackingParameters }, mDecompositionParameters { decompositionParameters }
+{
+  // Nothing to do
+}
+
+std::vector<std::vector<Track>> SectorTracker::clustersToTracks(const Event& event)
+{
+  const int sectorsNum { mDecompositionParameters.sectorsNum };
+  std::vector<int> socketDescriptors(sectorsNum, -1);
+  std::vector<pid_t> processIds(sectorsNum, -1);
+  std::vector<std::vector<Track>> tracks(event.getPrimaryVerticesNum());
+
+  splitEvent(event);
+  mSectorsTracks.resize(sectorsNum);
+
+  try {
+
+    for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+      int sectorSockets[2];
+
+      if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sectorSockets) != 0) {
+
+        throw std::runtime_error { "Sector socket creation failed" };
+      }
+
+      const pid_t processId { ::fork() };
+
+      if (processId < 0) {
+
+        ::close(sectorSockets[0]);
+        ::close(sectorSockets[1]);
+
+        throw std::runtime_error { "Sector process creation failed" };
+      }
+
+      if (processId == 0) {
+
+        int exitStatus { EXIT_SUCCESS };
+        ::close(sectorSockets[0]);
+
+        for (int iPreviousSector { 0 }; iPreviousSector < iSector; ++iPreviousSector) {
+
+          ::close(socketDescriptors[iPreviousSector]);
+        }
+
+        try {
+
+          serveSector(sectorSockets[1]);
+
+        } catch (...) {
+
+          exitStatus = EXIT_FAILURE;
+        }
+
+        ::_exit(exitStatus);
+      }
+
+      ::close(sectorSockets[1]);
+      socketDescriptors[iSector] = sectorSockets[0];
+      processIds[iSector] = processId;
+
+      sendEvent(socketDescriptors[iSector], mSectorEvents[iSector]);
+    }
+
+    for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+      mSectorsTracks[iSector] = receiveTracks(socketDescriptors[iSector]);
+    }
+
+  } catch (...) {
+
+    joinSectors(socketDescriptors, processIds);
+    throw;
+  }
+
+  if (!joinSectors(socketDescriptors, processIds)) {
+
+    throw std::runtime_error { "Sector process failed" };
+  }
+
+  mergeSectorsTracks(tracks);
+
+  return tracks;
+}
+
+void SectorTracker::serveSector(const int socketDescriptor) const
+{
+  /// The roads only make sense within the tracker that found them, the sector returns them as fitted tracks
+  TrackingParameters sectorTrackingParameters { mTrackingParameters };
+  sectorTrackingParameters.tracksFitting = true;
+
+  const Event sectorEvent { receiveEvent(socketDescriptor) };
+  Tracker<false> sectorTracker { sectorTrackingParameters };
+
+  sectorTracker.clustersToTracks(sectorEvent);
+  sendTracks(socketDescriptor, sectorTracker.getTracks());
+}
+
+void SectorTracker::splitEvent(const Event& event)
+{
+  TrackingUtils::splitPhiSectors(event, mDecompositionParameters, mSectorEvents, mClustersSectors);
+}
+
+void SectorTracker::mergeSectorsTracks(std::vector<std::vector<Track>>& tracks)
+{
+  const int sectorsNum { static_cast<int>(mSectorsTracks.size()) };
+  std::vector<std::vector<int>> clustersTracks(mClustersSectors.size());
+  std::vector<SectorTrack> sectorTracks { };
+  std::vector<SectorTrack> mergedTracks { };
+
+  for (int iVertex { 0 }; iVertex < static_cast<int>(tracks.size()); ++iVertex) {
+
+    sectorTracks.clear();
+
+    for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+      if (iVertex >= static_cast<int>(mSectorsTracks[iSector].size())) {
+
+        continue;
+      }
+
+      const std::vector<Track>& vertexTracks { mSectorsTracks[iSector][iVertex] };
+
+      for (int iTrack { 0 }; iTrack < static_cast<int>(vertexTracks.size()); ++iTrack) {
+
+        const Track& track { vertexTracks[iTrack] };
+        int clustersNum { 0 };
+        int innermostLayer { Constants::ITS::UnusedIndex };
+
+        for (int iLayer { Constants::ITS::LayersNumber - 1 }; iLayer >= 0; --iLayer) {
+
+          if (track.clusterIds[iLayer] != Constants::ITS::UnusedIndex) {
+
+            ++clustersNum;
+            innermostLayer = iLayer;
+          }
+        }
+
+        if (clustersNum > 0) {
+
+          const bool isOwned { mClustersSectors[track.clusterIds[innermostLayer]] == iSector };
+          sectorTracks.push_back(SectorTrack { &track, iSector, iTrack, clustersNum, innermostLayer, isOwned });
+        }
+      }
+    }
+
+    /// The longest copies come first, and among the equal ones the copy of the owner sector
+    std::stable_sort(sectorTracks.begin(), sectorTracks.end(),
+        [](const SectorTrack& firstTrack, const SectorTrack& secondTrack) {
+          return firstTrack.clustersNum > secondTrack.clustersNum
+              || (firstTrack.clustersNum == secondTrack.clustersNum && firstTrack.isOwned && !secondTrack.isOwned);
+        });
+
+    mergedTracks.clear();
+
+    for (const SectorTrack& sectorTrack : sectorTracks) {
+
+      const Track& track { *sectorTrack.track };
+      const std::vector<int>& innermostClusterTracks {
+          clustersTracks[track.clusterIds[sectorTrack.innermostLayer]] };
+      bool isContained { false };
+
+      for (int iMergedTrack : innermostClusterTracks) {
+
+        const Track& mergedTrack { *mergedTracks[iMergedTrack].track };
+        isContained = true;
+
+        for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber && isContained; ++iLayer) {
+
+          isContained = track.clusterIds[iLayer] == Constants::ITS::UnusedIndex
+              || track.clusterIds[iLayer] == mergedTrack.clusterIds[iLayer];
+        }
+
+        if (isContained) {
+
+          break;
+        }
+      }
+
+      if (isContained) {
+
+        continue;
+      }
+
+      for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+        if (track.clusterIds[iLayer] != Constants::ITS::UnusedIndex) {
+
+          clustersTracks[track.clusterIds[iLayer]].push_back(mergedTracks.size());
+        }
+      }
+
+      mergedTracks.push_back(sectorTrack);
+    }
+
+    /// The merged tracks are stored in the order of the sectors, as they were found
+    std::sort(mergedTracks.begin(), mergedTracks.end(),
+        [](const SectorTrack& firstTrack, const SectorTrack& secondTrack) {
+          return firstTrack.sectorIndex < secondTrack.sectorIndex
+              || (firstTrack.sectorIndex == secondTrack.sectorIndex && firstTrack.trackIndex < secondTrack.trackIndex);
+        });
+
+    for (const SectorTrack& mergedTrack : mergedTracks) {
+
+      const Track& track { *mergedTrack.track };
+      tracks[iVertex].push_back(track);
+
+      for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+        if (track.clusterIds[iLayer] != Constants::ITS::UnusedIndex) {
+
+          clustersTracks[track.clusterIds[iLayer]].clear();
+        }
+      }
+    }
+  }
+}
+#endif
+
+}
+}
+}
@@ -0,0 +1,33 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Track.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/Track.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+Track::Track()
+    : curvature { 0.f }, phiCoordinate { 0.f }, impactParameter { 0.f }, zCoordinate { 0.f }, tanLambda { 0.f }, chi2 {
+        0.f }, degreesOfFreedom { 0 }, label { Constants::ITS::UnusedIndex }
+{
+  clusterIds.fill(Constants::ITS::UnusedIndex);
+}
+
+}
+}
+}
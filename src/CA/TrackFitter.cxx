@@ -0,0 +1,257 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file TrackFitter.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/TrackFitter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ITSReconstruction/CA/Cell.h"
+#include "ITSReconstruction/CA/MathUtils.h"
+#include "ITSReconstruction/CA/Road.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+constexpr int TrackFitter::BatchSize;
+
+TrackFitter::TrackFitter()
+{
+  // Nothing to do
+}
+
+void TrackFitter::fitRoads(PrimaryVertexContext& primaryVertexContext, std::vector<Track>& tracks)
+{
+  const int roadsNum { static_cast<int>(primaryVertexContext.getRoads().size()) };
+  const int firstTrackIndex { static_cast<int>(tracks.size()) };
+
+  tracks.resize(firstTrackIndex + roadsNum);
+
+  for (int iRoad { 0 }; iRoad < roadsNum; iRoad += BatchSize) {
+
+    const int batchTracksNum { std::min(BatchSize, roadsNum - iRoad) };
+    Track* batchTracks { tracks.data() + firstTrackIndex + iRoad };
+
+    loadBatch(primaryVertexContext, iRoad, batchTracksNum, batchTracks);
+    fitBatch();
+    storeBatch(batchTracksNum, batchTracks);
+  }
+}
+
+void TrackFitter::loadBatch(PrimaryVertexContext& primaryVertexContext, const int firstRoadIndex,
+    const int tracksNum, Track* tracks)
+{
+  const float3& primaryVertex { primaryVertexContext.getPrimaryVertex() };
+
+  for (int iTrack { 0 }; iTrack < BatchSize; ++iTrack) {
+
+    std::array<int, Constants::ITS::LayersNumber> clusterIndexes;
+    clusterIndexes.fill(Constants::ITS::UnusedIndex);
+
+    if (iTrack < tracksNum) {
+
+      Road& currentRoad { primaryVertexContext.getRoads()[firstRoadIndex + iTrack] };
+
+      for (int iCell { 0 }; iCell < Constants::ITS::CellsPerRoad; ++iCell) {
+
+        if (currentRoad[iCell] == Constants::ITS::UnusedIndex) {
+
+          continue;
+        }
+
+        const Cell& currentCell { primaryVertexContext.getCells()[iCell][currentRoad[iCell]] };
+        clusterIndexes[iCell] = currentCell.getFirstClusterIndex();
+        clusterIndexes[iCell + 1] = currentCell.getSecondClusterIndex();
+        clusterIndexes[iCell + 2] = currentCell.getThirdClusterIndex();
+      }
+
+      tracks[iTrack].label = currentRoad.getLabel();
+    }
+
+    /// The conformal frame is rotated so that the innermost cluster lies on the positive u axis
+    float rotationAngle { 0.f };
+
+    for (int iLayer { Constants::ITS::LayersNumber - 1 }; iLayer >= 0; --iLayer) {
+
+      if (clusterIndexes[iLayer] != Constants::ITS::UnusedIndex) {
+
+        rotationAngle = primaryVertexContext.getClusters()[iLayer][clusterIndexes[iLayer]].phiCoordinate;
+      }
+    }
+
+    const double cosAngle { std::cos(rotationAngle) };
+    const double sinAngle { std::sin(rotationAngle) };
+    mRotationAngles[iTrack] = rotationAngle;
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+      if (clusterIndexes[iLayer] == Constants::ITS::UnusedIndex) {
+
+        mUCoordinates[iLayer][iTrack] = 0.;
+        mVCoordinates[iLayer][iTrack] = 0.;
+        mVVariances[iLayer][iTrack] = 1.;
+        mRCoordinates[iLayer][iTrack] = 0.;
+        mZCoordinates[iLayer][iTrack] = 0.;
+        mWeights[iLayer][iTrack] = 0.;
+
+        continue;
+      }
+
+      const Cluster& currentCluster { primaryVertexContext.getClusters()[iLayer][clusterIndexes[iLayer]] };
+      const double xCoordinate { currentCluster.xCoordinate - primaryVertex.x };
+      const double yCoordinate { currentCluster.yCoordinate - primaryVertex.y };
+      const double rotatedXCoordinate { cosAngle * xCoordinate + sinAngle * yCoordinate };
+      const double rotatedYCoordinate { -sinAngle * xCoordinate + cosAngle * yCoordinate };
+      const double quadraticRCoordinate { rotatedXCoordinate * rotatedXCoordinate
+          + rotatedYCoordinate * rotatedYCoordinate };
+      const double vResolution { Constants::Fitting::ClusterResolutionRPhi / quadraticRCoordinate };
+
+      mUCoordinates[iLayer][iTrack] = rotatedXCoordinate / quadraticRCoordinate;
+      mVCoordinates[iLayer][iTrack] = rotatedYCoordinate / quadraticRCoordinate;
+      mVVariances[iLayer][iTrack] = vResolution * vResolution;
+      mRCoordinates[iLayer][iTrack] = std::sqrt(quadraticRCoordinate);
+      mZCoordinates[iLayer][iTrack] = currentCluster.zCoordinate - primaryVertex.z;
+      mWeights[iLayer][iTrack] = 1.;
+      tracks[iTrack].clusterIds[iLayer] = currentCluster.clusterId;
+    }
+  }
+}
+
+void TrackFitter::fitBatch()
+{
+  BatchArray& a { mTransverseParameters[0] };
+  BatchArray& b { mTransverseParameters[1] };
+  BatchArray& c { mTransverseParameters[2] };
+  BatchArray& p00 { mTransverseCovariances[0] };
+  BatchArray& p01 { mTransverseCovariances[1] };
+  BatchArray& p02 { mTransverseCovariances[2] };
+  BatchArray& p11 { mTransverseCovariances[3] };
+  BatchArray& p12 { mTransverseCovariances[4] };
+  BatchArray& p22 { mTransverseCovariances[5] };
+  BatchArray& z0 { mLongitudinalParameters[0] };
+  BatchArray& tanLambda { mLongitudinalParameters[1] };
+  BatchArray& q00 { mLongitudinalCovariances[0] };
+  BatchArray& q01 { mLongitudinalCovariances[1] };
+  BatchArray& q11 { mLongitudinalCovariances[2] };
+
+  for (int iTrack { 0 }; iTrack < BatchSize; ++iTrack) {
+
+    a[iTrack] = b[iTrack] = c[iTrack] = 0.;
+    p00[iTrack] = p11[iTrack] = p22[iTrack] = Constants::Fitting::InitialCovariance;
+    p01[iTrack] = p02[iTrack] = p12[iTrack] = 0.;
+    z0[iTrack] = tanLambda[iTrack] = 0.;
+    q00[iTrack] = q11[iTrack] = Constants::Fitting::InitialCovariance;
+    q01[iTrack] = 0.;
+    mChi2[iTrack] = 0.;
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    const BatchArray& u { mUCoordinates[iLayer] };
+    const BatchArray& v { mVCoordinates[iLayer] };
+    const BatchArray& variance { mVVariances[iLayer] };
+    const BatchArray& weight { mWeights[iLayer] };
+
+    for (int iTrack { 0 }; iTrack < BatchSize; ++iTrack) {
+
+      const double quadraticU { u[iTrack] * u[iTrack] };
+      const double ph0 { p00[iTrack] + p01[iTrack] * u[iTrack] + p02[iTrack] * quadraticU };
+      const double ph1 { p01[iTrack] + p11[iTrack] * u[iTrack] + p12[iTrack] * quadraticU };
+      const double ph2 { p02[iTrack] + p12[iTrack] * u[iTrack] + p22[iTrack] * quadraticU };
+      const double residualVariance { ph0 + ph1 * u[iTrack] + ph2 * quadraticU + variance[iTrack] };
+      const double residual { v[iTrack] - a[iTrack] - b[iTrack] * u[iTrack] - c[iTrack] * quadraticU };
+      const double gain { weight[iTrack] / residualVariance };
+      const double k0 { ph0 * gain };
+      const double k1 { ph1 * gain };
+      const double k2 { ph2 * gain };
+
+      a[iTrack] += k0 * residual;
+      b[iTrack] += k1 * residual;
+      c[iTrack] += k2 * residual;
+      p00[iTrack] -= k0 * ph0;
+      p01[iTrack] -= k0 * ph1;
+      p02[iTrack] -= k0 * ph2;
+      p11[iTrack] -= k1 * ph1;
+      p12[iTrack] -= k1 * ph2;
+      p22[iTrack] -= k2 * ph2;
+      mChi2[iTrack] += gain * residual * residual;
+    }
+  }
+
+  const double zVariance { Constants::Fitting::ClusterResolutionZ * Constants::Fitting::ClusterResolutionZ };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    const BatchArray& r { mRCoordinates[iLayer] };
+    const BatchArray& z { mZCoordinates[iLayer] };
+    const BatchArray& weight { mWeights[iLayer] };
+
+    for (int iTrack { 0 }; iTrack < BatchSize; ++iTrack) {
+
+      /// Transverse arc length from the primary vertex, with the signed curvature 2 * a / sqrt(1 + b^2)
+      const double halfCurvature { a[iTrack] / std::sqrt(1. + b[iTrack] * b[iTrack]) };
+      const double sinHalfAngle { std::max(-1., std::min(1., halfCurvature * r[iTrack])) };
+      const double arcLength { std::abs(halfCurvature) > Constants::Math::FloatMinThreshold ?
+          std::asin(sinHalfAngle) / halfCurvature : r[iTrack] };
+      const double qh0 { q00[iTrack] + q01[iTrack] * arcLength };
+      const double qh1 { q01[iTrack] + q11[iTrack] * arcLength };
+      const double residualVariance { qh0 + qh1 * arcLength + zVariance };
+      const double residual { z[iTrack] - z0[iTrack] - tanLambda[iTrack] * arcLength };
+      const double gain { weight[iTrack] / residualVariance };
+      const double k0 { qh0 * gain };
+      const double k1 { qh1 * gain };
+
+      z0[iTrack] += k0 * residual;
+      tanLambda[iTrack] += k1 * residual;
+      q00[iTrack] -= k0 * qh0;
+      q01[iTrack] -= k0 * qh1;
+      q11[iTrack] -= k1 * qh1;
+      mChi2[iTrack] += gain * residual * residual;
+    }
+  }
+}
+
+void TrackFitter::storeBatch(const int tracksNum, Track* tracks) const
+{
+  for (int iTrack { 0 }; iTrack < tracksNum; ++iTrack) {
+
+    Track& currentTrack { tracks[iTrack] };
+    const double a { mTransverseParameters[0][iTrack] };
+    const double b { mTransverseParameters[1][iTrack] };
+    const double c { mTransverseParameters[2][iTrack] };
+    const double directionNorm { std::sqrt(1. + b * b) };
+    int clustersNum { 0 };
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+      clustersNum += mWeights[iLayer][iTrack] > 0.;
+    }
+
+    currentTrack.curvature = 2. * a / directionNorm;
+    currentTrack.phiCoordinate = MathUtils::getNormalizedPhiCoordinate(mRotationAngles[iTrack] + std::atan(b));
+    currentTrack.impactParameter = (a < 0. ? c : -c) / (directionNorm * directionNorm * directionNorm);
+    currentTrack.zCoordinate = mLongitudinalParameters[0][iTrack];
+    currentTrack.tanLambda = mLongitudinalParameters[1][iTrack];
+    currentTrack.chi2 = mChi2[iTrack];
+    currentTrack.degreesOfFreedom = 2 * clustersNum - 5;
+  }
+}
+
+}
+}
+}
@@ -14,13 +14,16 @@
 
 #include "ITSReconstruction/CA/Tracker.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <ctime>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 
 #include "ITSReconstruction/CA/Cell.h"
 #include "ITSReconstruction/CA/Constants.h"
@@ -41,533 +44,1347 @@ namespace CA
 {
 
 #if !TRACKINGITSU_GPU_MODE
+namespace
+{
+
+/// Tracklets finding of a range of clusters of a layer on any search copy of the next layer providing
+/// forEachCandidatesRange and getClusterIndex
+template<typename SearchLayer>
+void computeSearchLayerTracklets(PrimaryVertexContext& primaryVertexContext, const SearchLayer& nextLayer,
+    const int iLayer, const int firstClusterIndex, const int maxClusterIndex)
+{
+  const float3 &primaryVertex = primaryVertexContext.getPrimaryVertex();
+  const std::vector<bool>& currentLayerUsedClusters { primaryVertexContext.getUsedClustersTable()[iLayer] };
+  const std::vector<bool>& nextLayerUsedClusters { primaryVertexContext.getUsedClustersTable()[iLayer + 1] };
+
+  for (int iCluster { firstClusterIndex }; iCluster < maxClusterIndex; ++iCluster) {
+
+    if (currentLayerUsedClusters[iCluster]) {
+
+      continue;
+    }
+
+    const Cluster& currentCluster { primaryVertexContext.getClusters()[iLayer][iCluster] };
+
+    const float tanLambda { (currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate };
+    const float directionZIntersection { tanLambda
+        * (Constants::ITS::LayersRCoordinate()[iLayer + 1] - currentCluster.rCoordinate)
+        + currentCluster.zCoordinate };
+
+    auto candidatesRangeFunction = [&](const int firstClusterIndex, const int maxClusterIndex) {
+
+      for (int iSearchCluster { firstClusterIndex }; iSearchCluster < maxClusterIndex; ++iSearchCluster) {
+
+        const int iNextLayerCluster { nextLayer.getClusterIndex(iSearchCluster) };
+
+        if (nextLayerUsedClusters[iNextLayerCluster]) {
+
+          continue;
+        }
+
+        const float deltaZ { MATH_ABS(
+            tanLambda * (nextLayer.rCoordinates[iSearchCluster] - currentCluster.rCoordinate)
+                + currentCluster.zCoordinate - nextLayer.zCoordinates[iSearchCluster]) };
+        const float deltaPhi { MATH_ABS(currentCluster.phiCoordinate - nextLayer.phiCoordinates[iSearchCluster]) };
+
+        if (deltaZ < Constants::Thresholds::TrackletMaxDeltaZThreshold()[iLayer]
+            && deltaPhi < Constants::Thresholds::PhiCoordinateCut) {
+
+          HugePagesVector<Tracklet>& layerTracklets { primaryVertexContext.getTracklets()[iLayer] };
+
+          if (layerTracklets.size() == layerTracklets.capacity()) {
+
+            primaryVertexContext.growTracklets(iLayer);
+          }
+
+          layerTracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster,
+              primaryVertexContext.getClusters()[iLayer + 1][iNextLayerCluster]);
+        }
+      }
+    };
+
+    nextLayer.forEachCandidatesRange(currentCluster, directionZIntersection, candidatesRangeFunction);
+  }
+}
+
+/// Tracklets finding of a range of clusters of a layer on the padded layer of the dispatched granularity
+struct PaddedLayerTrackletsFinder final
+{
+    template<int Granularity>
+    void operator()(std::integral_constant<int, Granularity>) const
+    {
+      computeSearchLayerTracklets(primaryVertexContext, primaryVertexContext.getPaddedLayers<Granularity>()[iLayer],
+          iLayer, firstClusterIndex, maxClusterIndex);
+    }
+
+    PrimaryVertexContext& primaryVertexContext;
+    const int iLayer;
+    const int firstClusterIndex;
+    const int maxClusterIndex;
+};
+
+/// Tracklets finding of a range of clusters of a layer on the search copy selected for the next layer
+void computeClustersRangeTracklets(PrimaryVertexContext& primaryVertexContext, const int iLayer,
+    const int firstClusterIndex, const int maxClusterIndex)
+{
+  if (firstClusterIndex == maxClusterIndex || primaryVertexContext.getClusters()[iLayer + 1].empty()) {
+
+    return;
+  }
+
+  if (primaryVertexContext.getIndexTableSearchEngines()[iLayer] == Constants::IndexTable::PhiSortedSearchEngine) {
+
+    computeSearchLayerTracklets(primaryVertexContext, primaryVertexContext.getPhiSortedLayers()[iLayer], iLayer,
+        firstClusterIndex, maxClusterIndex);
+    return;
+  }
+
+  if (primaryVertexContext.getIndexTableSearchEngines()[iLayer]
+      == Constants::IndexTable::HierarchicalGridSearchEngine) {
+
+    computeSearchLayerTracklets(primaryVertexContext, primaryVertexContext.getHierarchicalGridLayers()[iLayer],
+        iLayer, firstClusterIndex, maxClusterIndex);
+    return;
+  }
+
+  dispatchGranularity(primaryVertexContext.getIndexTableGranularities()[iLayer],
+      PaddedLayerTrackletsFinder { primaryVertexContext, iLayer, firstClusterIndex, maxClusterIndex });
+}
+
+/// Cells finding of a range of tracklets of a layer
+void computeTrackletsRangeCells(PrimaryVertexContext& primaryVertexContext, const int iLayer,
+    const int firstTrackletIndex, const int maxTrackletIndex)
+{
+  const float3 &primaryVertex = primaryVertexContext.getPrimaryVertex();
+  const HugePagesVector<Tracklet>& currentLayerTracklets { primaryVertexContext.getTracklets()[iLayer] };
+  const std::vector<int>& trackletsLookupTable { primaryVertexContext.getTrackletsLookupTable()[iLayer] };
+
+  for (int iTracklet { firstTrackletIndex }; iTracklet < maxTrackletIndex; ++iTracklet) {
+
+    /// The lookup table entry of a later tracklet is prefetched first, then the next layer tracklets it points to
+    if (iTracklet + Constants::Memory::PrefetchDistance < maxTrackletIndex) {
+
+      const int prefetchedClusterIndex {
+          currentLayerTracklets[iTracklet + Constants::Memory::PrefetchDistance].secondClusterIndex };
+      MEMORY_PREFETCH(&trackletsLookupTable[prefetchedClusterIndex]);
+      MEMORY_PREFETCH(&primaryVertexContext.getClusters()[iLayer + 1][prefetchedClusterIndex]);
+    }
+
+    if (iTracklet + Constants::Memory::PrefetchDistance / 2 < maxTrackletIndex) {
+
+      const int prefetchedClusterIndex {
+          currentLayerTracklets[iTracklet + Constants::Memory::PrefetchDistance / 2].secondClusterIndex };
+      const int prefetchedTrackletIndex { trackletsLookupTable[prefetchedClusterIndex] };
+
+      if (prefetchedTrackletIndex < static_cast<int>(primaryVertexContext.getTracklets()[iLayer + 1].size())) {
+
+        MEMORY_PREFETCH(&primaryVertexContext.getTracklets()[iLayer + 1][prefetchedTrackletIndex]);
+      }
+    }
+
+    const Tracklet& currentTracklet { currentLayerTracklets[iTracklet] };
+    const int nextLayerClusterIndex { currentTracklet.secondClusterIndex };
+    const int nextLayerFirstTrackletIndex { trackletsLookupTable[nextLayerClusterIndex] };
+    const int nextLayerMaxTrackletIndex { trackletsLookupTable[nextLayerClusterIndex + 1] };
+
+    if (nextLayerFirstTrackletIndex == nextLayerMaxTrackletIndex) {
+
+      continue;
+    }
+
+    const Cluster& firstCellCluster { primaryVertexContext.getClusters()[iLayer][currentTracklet.firstClusterIndex] };
+    const Cluster& secondCellCluster {
+        primaryVertexContext.getClusters()[iLayer + 1][currentTracklet.secondClusterIndex] };
+    const float firstCellClusterQuadraticRCoordinate { firstCellCluster.rCoordinate * firstCellCluster.rCoordinate };
+    const float secondCellClusterQuadraticRCoordinate { secondCellCluster.rCoordinate * secondCellCluster.rCoordinate };
+    const float3 firstDeltaVector { secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+        secondCellCluster.yCoordinate - firstCellCluster.yCoordinate, secondCellClusterQuadraticRCoordinate
+            - firstCellClusterQuadraticRCoordinate };
+
+    for (int iNextLayerTracklet { nextLayerFirstTrackletIndex }; iNextLayerTracklet < nextLayerMaxTrackletIndex;
+        ++iNextLayerTracklet) {
+
+      const Tracklet& nextTracklet { primaryVertexContext.getTracklets()[iLayer + 1][iNextLayerTracklet] };
+      const float deltaTanLambda { std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda) };
+      const float deltaPhi { std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate) };
+
+      if (deltaTanLambda < Constants::Thresholds::CellMaxDeltaTanLambdaThreshold
+          && (deltaPhi < Constants::Thresholds::CellMaxDeltaPhiThreshold
+              || std::abs(deltaPhi - Constants::Math::TwoPi) < Constants::Thresholds::CellMaxDeltaPhiThreshold)) {
+
+        const float averageTanLambda { 0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda) };
+        const float directionZIntersection { -averageTanLambda * firstCellCluster.rCoordinate
+            + firstCellCluster.zCoordinate };
+        const float deltaZ { std::abs(directionZIntersection - primaryVertex.z) };
+
+        if (deltaZ < Constants::Thresholds::CellMaxDeltaZThreshold()[iLayer]) {
+
+          const Cluster& thirdCellCluster {
+              primaryVertexContext.getClusters()[iLayer + 2][nextTracklet.secondClusterIndex] };
+
+          const float thirdCellClusterQuadraticRCoordinate { thirdCellCluster.rCoordinate
+              * thirdCellCluster.rCoordinate };
+
+          const float3 secondDeltaVector { thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+              thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate, thirdCellClusterQuadraticRCoordinate
+                  - firstCellClusterQuadraticRCoordinate };
+
+          float3 cellPlaneNormalVector { MathUtils::crossProduct(firstDeltaVector, secondDeltaVector) };
+
+          const float vectorNorm { std::sqrt(
+              cellPlaneNormalVector.x * cellPlaneNormalVector.x + cellPlaneNormalVector.y * cellPlaneNormalVector.y
+                  + cellPlaneNormalVector.z * cellPlaneNormalVector.z) };
+
+          if (vectorNorm < Constants::Math::FloatMinThreshold
+              || std::abs(cellPlaneNormalVector.z) < Constants::Math::FloatMinThreshold) {
+
+            continue;
+          }
+
+          const float inverseVectorNorm { 1.0f / vectorNorm };
+          const float3 normalizedPlaneVector { cellPlaneNormalVector.x * inverseVectorNorm, cellPlaneNormalVector.y
+              * inverseVectorNorm, cellPlaneNormalVector.z * inverseVectorNorm };
+          const float planeDistance { -normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x)
+              - (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y)
+              - normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate };
+          const float normalizedPlaneVectorQuadraticZCoordinate { normalizedPlaneVector.z * normalizedPlaneVector.z };
+          const float cellTrajectoryRadius { std::sqrt(
+              (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z)
+                  / (4.0f * normalizedPlaneVectorQuadraticZCoordinate)) };
+          const float2 circleCenter { -0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z, -0.5f
+              * normalizedPlaneVector.y / normalizedPlaneVector.z };
+          const float distanceOfClosestApproach { std::abs(
+              cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y)) };
+
+          if (distanceOfClosestApproach
+              > Constants::Thresholds::CellMaxDistanceOfClosestApproachThreshold()[iLayer]) {
+
+            continue;
+          }
+
+          const float cellTrajectoryCurvature { 1.0f / cellTrajectoryRadius };
+
+          HugePagesVector<Cell>& layerCells { primaryVertexContext.getCells()[iLayer] };
+
+          if (layerCells.size() == layerCells.capacity()) {
+
+            primaryVertexContext.growCells(iLayer);
+          }
+
+          layerCells.emplace_back(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex,
+              nextTracklet.secondClusterIndex, iTracklet, iNextLayerTracklet, normalizedPlaneVector,
+              cellTrajectoryCurvature);
+        }
+      }
+    }
+  }
+}
+
+/// Splits the event in phi sectors of consecutive index table rows, each holding at most
+/// Constants::Memory::PhiSectorMaxBytes of clusters over all the layers (a single row may exceed it). The entry s of
+/// the result holds the first cluster of the sector s in each layer, the last one the clusters number of each layer
+std::vector<std::array<int, Constants::ITS::LayersNumber>> computePhiSectors(PrimaryVertexContext& primaryVertexContext)
+{
+  std::array<std::array<int, Constants::IndexTable::PhiBins + 1>, Constants::ITS::LayersNumber> rowsFirstClusters;
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    const std::vector<Cluster>& layerClusters { primaryVertexContext.getClusters()[iLayer] };
+    rowsFirstClusters[iLayer].front() = 0;
+    rowsFirstClusters[iLayer].back() = static_cast<int>(layerClusters.size());
+
+    for (int iPhiBin { 1 }; iPhiBin < Constants::IndexTable::PhiBins; ++iPhiBin) {
+
+      const int rowFirstBinIndex { IndexTableUtils::getBinIndex(0, iPhiBin) };
+      rowsFirstClusters[iLayer][iPhiBin] = std::lower_bound(layerClusters.begin(), layerClusters.end(),
+          rowFirstBinIndex, [](const Cluster& cluster, const int binIndex) {
+            return cluster.indexTableBinIndex < binIndex;
+          }) - layerClusters.begin();
+    }
+  }
+
+  std::vector<std::array<int, Constants::ITS::LayersNumber>> phiSectors { };
+  std::array<int, Constants::ITS::LayersNumber> sectorFirstClusters;
+  int sectorBytes { 0 };
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    sectorFirstClusters[iLayer] = 0;
+  }
+
+  phiSectors.push_back(sectorFirstClusters);
+
+  for (int iPhiBin { 0 }; iPhiBin < Constants::IndexTable::PhiBins; ++iPhiBin) {
+
+    int rowBytes { 0 };
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+      rowBytes += (rowsFirstClusters[iLayer][iPhiBin + 1] - rowsFirstClusters[iLayer][iPhiBin]) * sizeof(Cluster);
+    }
+
+    if (sectorBytes > 0 && sectorBytes + rowBytes > Constants::Memory::PhiSectorMaxBytes) {
+
+      for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+        sectorFirstClusters[iLayer] = rowsFirstClusters[iLayer][iPhiBin];
+      }
+
+      phiSectors.push_back(sectorFirstClusters);
+      sectorBytes = 0;
+    }
+
+    sectorBytes += rowBytes;
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    sectorFirstClusters[iLayer] = rowsFirstClusters[iLayer].back();
+  }
+
+  phiSectors.push_back(sectorFirstClusters);
+
+  return phiSectors;
+}
+
+}
+
 template<>
 void TrackerTraits<false>::computeLayerTracklets(PrimaryVertexContext& primaryVertexContext)
 {
   for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-    if (primaryVertexContext.getClusters()[iLayer].empty() || primaryVertexContext.getClusters()[iLayer + 1].empty()) {
+    computeLayerTracklets(primaryVertexContext, iLayer);
+  }
+}
+
+template<>
+void TrackerTraits<false>::computeLayerTracklets(PrimaryVertexContext& primaryVertexContext, const int iLayer)
+{
+  computeClustersRangeTracklets(primaryVertexContext, iLayer, 0,
+      static_cast<int>(primaryVertexContext.getClusters()[iLayer].size()));
+
+  if (iLayer > 0) {
+
+    primaryVertexContext.buildTrackletsLookupTable(iLayer - 1);
+  }
+}
+
+template<>
+void TrackerTraits<false>::computeLayerCells(PrimaryVertexContext& primaryVertexContext)
+{
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    computeLayerCells(primaryVertexContext, iLayer);
+  }
+}
+
+template<>
+void TrackerTraits<false>::computeLayerCells(PrimaryVertexContext& primaryVertexContext, const int iLayer)
+{
+  computeTrackletsRangeCells(primaryVertexContext, iLayer, 0,
+      static_cast<int>(primaryVertexContext.getTracklets()[iLayer].size()));
+
+  if (iLayer > 0) {
+
+    primaryVertexContext.buildCellsLookupTable(iLayer - 1);
+  }
+}
+
+template<>
+void TrackerTraits<false>::computePhiSectorsTracklets(PrimaryVertexContext& primaryVertexContext)
+{
+  /// The tracklets of a phi sector are found layer after layer, so that the next layer clusters searched for a
+  /// layer are still cached when they become the current layer clusters. The sectors are visited in phi order, like
+  /// the clusters, so every layer tracklets come out in the same order as with the layer by layer traversal
+  const std::vector<std::array<int, Constants::ITS::LayersNumber>> phiSectors { computePhiSectors(
+      primaryVertexContext) };
+  const int phiSectorsNum { static_cast<int>(phiSectors.size()) - 1 };
+
+  for (int iPhiSector { 0 }; iPhiSector < phiSectorsNum; ++iPhiSector) {
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+      computeClustersRangeTracklets(primaryVertexContext, iLayer, phiSectors[iPhiSector][iLayer],
+          phiSectors[iPhiSector + 1][iLayer]);
+    }
+  }
+
+  for (int iLayer { 1 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    primaryVertexContext.buildTrackletsLookupTable(iLayer - 1);
+  }
+}
+
+template<>
+void TrackerTraits<false>::computePhiSectorsCells(PrimaryVertexContext& primaryVertexContext)
+{
+  /// Same traversal as computePhiSectorsTracklets, the tracklets of a sector being those starting from its clusters
+  const std::vector<std::array<int, Constants::ITS::LayersNumber>> phiSectors { computePhiSectors(
+      primaryVertexContext) };
+  const int phiSectorsNum { static_cast<int>(phiSectors.size()) - 1 };
+  std::array<int, Constants::ITS::CellsPerRoad> sectorFirstTracklets;
+
+  sectorFirstTracklets.fill(0);
+
+  for (int iPhiSector { 0 }; iPhiSector < phiSectorsNum; ++iPhiSector) {
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+      const HugePagesVector<Tracklet>& layerTracklets { primaryVertexContext.getTracklets()[iLayer] };
+      const int sectorMaxCluster { phiSectors[iPhiSector + 1][iLayer] };
+      const int sectorMaxTracklet = std::lower_bound(layerTracklets.begin() + sectorFirstTracklets[iLayer],
+          layerTracklets.end(), sectorMaxCluster, [](const Tracklet& tracklet, const int clusterIndex) {
+            return tracklet.firstClusterIndex < clusterIndex;
+          }) - layerTracklets.begin();
+
+      computeTrackletsRangeCells(primaryVertexContext, iLayer, sectorFirstTracklets[iLayer], sectorMaxTracklet);
+      sectorFirstTracklets[iLayer] = sectorMaxTracklet;
+    }
+  }
+
+  for (int iLayer { 1 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    primaryVertexContext.buildCellsLookupTable(iLayer - 1);
+  }
+}
+
+template<>
+void TrackerTraits<false>::pruneLayerTracklets(PrimaryVertexContext& primaryVertexContext, const int iLayer)
+{
+  /// A tracklet can only take part in a cell if a tracklet of the next layer starts from its second cluster or a
+  /// tracklet of the previous layer ends on its first cluster. All the other tracklets are dropped in place.
+  HugePagesVector<Tracklet>& layerTracklets { primaryVertexContext.getTracklets()[iLayer] };
+  const bool hasNextLayer { iLayer < Constants::ITS::TrackletsPerRoad - 1 };
+  const bool hasPreviousLayer { iLayer > 0 };
+
+  if (hasPreviousLayer) {
+
+    std::vector<unsigned char>& incomingTracklets { primaryVertexContext.getIncomingTrackletsTable()[iLayer - 1] };
+    incomingTracklets.assign(primaryVertexContext.getClusters()[iLayer].size(), 0);
+
+    for (const Tracklet& previousLayerTracklet : primaryVertexContext.getTracklets()[iLayer - 1]) {
+
+      incomingTracklets[previousLayerTracklet.secondClusterIndex] = 1;
+    }
+  }
+
+  const int layerTrackletsNum { static_cast<int>(layerTracklets.size()) };
+  int keptTrackletsNum { 0 };
+
+  for (int iTracklet { 0 }; iTracklet < layerTrackletsNum; ++iTracklet) {
+
+    const Tracklet& currentTracklet { layerTracklets[iTracklet] };
+    const bool hasNextTracklet { hasNextLayer
+        && primaryVertexContext.getTrackletsLookupTable()[iLayer][currentTracklet.secondClusterIndex + 1]
+            > primaryVertexContext.getTrackletsLookupTable()[iLayer][currentTracklet.secondClusterIndex] };
+    const bool hasPreviousTracklet { hasPreviousLayer
+        && primaryVertexContext.getIncomingTrackletsTable()[iLayer - 1][currentTracklet.firstClusterIndex] };
+
+    if (!hasNextTracklet && !hasPreviousTracklet) {
+
+      continue;
+    }
+
+    layerTracklets[keptTrackletsNum++] = currentTracklet;
+  }
+
+  layerTracklets.erase(layerTracklets.begin() + keptTrackletsNum, layerTracklets.end());
+
+  if (hasPreviousLayer) {
+
+    primaryVertexContext.buildTrackletsLookupTable(iLayer - 1);
+  }
+}
+#endif
+
+template<bool IsGPU>
+Tracker<IsGPU>::Tracker()
+    : mCurrentIteration { 0 }, mEnforcedMemoryBudget { 0 }, mCurrentChunk { Constants::ITS::UnusedIndex }, mReport {
+        TrackingReport::None }, mReportStream { nullptr }
+{
+  // Nothing to do
+}
+
+template<bool IsGPU>
+Tracker<IsGPU>::Tracker(const TrackingParameters& trackingParameters)
+    : mTrackingParameters { trackingParameters }, mCurrentIteration { 0 }, mEnforcedMemoryBudget { 0 },
+        mCurrentChunk { Constants::ITS::UnusedIndex }, mReport { TrackingReport::None }, mReportStream { nullptr }
+{
+  // Nothing to do
+}
+
+template<bool IsGPU>
+Tracker<IsGPU>::Tracker(const TrackingParameters& trackingParameters, const MemoryParameters& memoryParameters)
+    : mTrackingParameters { trackingParameters }, mCurrentIteration { 0 }, mEnforcedMemoryBudget { 0 },
+        mCurrentChunk { Constants::ITS::UnusedIndex }, mReport { TrackingReport::None }, mReportStream { nullptr }
+{
+  mPrimaryVertexContext.setMemoryParameters(memoryParameters);
+}
+
+template<bool IsGPU>
+std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracks(const Event& event)
+{
+  std::vector<std::vector<Road>> roads { };
+#if !TRACKINGITSU_GPU_MODE
+  const std::size_t memoryBudget { getMemoryParameters().memoryBudget };
+
+  if (memoryBudget > 0) {
+
+    if (mPrimaryVertexContext.getMemorySize() > memoryBudget) {
+
+      mPrimaryVertexContext.releaseMemory();
+      mPrimaryVertexContext.releaseClustersMemory();
+    }
+
+    /// The event is split in the predicted number of chunks, doubled every time a chunk vertex exceeds the budget
+    /// (see trackEventChunks). The event fails if it does not fit even in the most chunks
+    const std::size_t predictedMemorySize { mPrimaryVertexContext.getPredictedMemorySize(event) };
+    int chunksNum { std::max(1, static_cast<int>(std::min<std::size_t>(
+        (predictedMemorySize + memoryBudget - 1) / memoryBudget, Constants::Memory::MaxChunksNum))) };
+    mEnforcedMemoryBudget = memoryBudget;
+
+    for (;; chunksNum = std::min(2 * chunksNum, Constants::Memory::MaxChunksNum)) {
+
+      const bool isTracked { chunksNum > 1 ? trackEventChunks(event, chunksNum, roads) : trackEvent(event, roads) };
+
+      if (isTracked) {
+
+        break;
+      }
+
+      /// The clusters arrays retained from the larger chunks would otherwise count against the smaller ones
+      mPrimaryVertexContext.releaseMemory();
+      mPrimaryVertexContext.releaseClustersMemory();
+
+      if (chunksNum == Constants::Memory::MaxChunksNum) {
+
+        mEnforcedMemoryBudget = 0;
+        throw std::runtime_error { "Memory budget exceeded by every chunk split of the event" };
+      }
+    }
+
+    mEnforcedMemoryBudget = 0;
+
+    return roads;
+  }
+#endif
+
+  trackEvent(event, roads);
+
+  return roads;
+}
+
+template<bool IsGPU>
+bool Tracker<IsGPU>::trackEvent(const Event& event, std::vector<std::vector<Road>>& roads)
+{
+  const int verticesNum { event.getPrimaryVerticesNum() };
+#if TRACKINGITSU_GPU_MODE
+  const int iterationsNum { std::min(1, static_cast<int>(mTrackingParameters.cellsMinimumLevel.size())) };
+#else
+  const int iterationsNum { static_cast<int>(mTrackingParameters.cellsMinimumLevel.size()) };
+#endif
+  bool isTracked { true };
+  selectIndexTables(event);
+#if !TRACKINGITSU_GPU_MODE
+  mPrimaryVertexContext.setMemoryBudget(event, mEnforcedMemoryBudget);
+#endif
+  roads.clear();
+  roads.reserve(verticesNum);
+  mTracks.clear();
+  mTracks.reserve(verticesNum);
+
+  for (int iVertex { 0 }; iVertex < verticesNum && isTracked; ++iVertex) {
+
+    /// Times of the initialization and of the tracklets, cells, neighbours, tracks and labels stages of the vertex,
+    /// summed over the iterations. The total also counts the initialization and the tracks fitting
+    std::array<float, 6> stagesTimes { };
+    float totalTime { };
+    VertexOccupancy vertexOccupancy { };
+    clock_t t1 { clock() };
+
+    mPrimaryVertexContext.initialize(event, iVertex);
+
+    if (mReport != TrackingReport::None) {
+
+      stagesTimes[0] = ((float) clock() - (float) t1) / (CLOCKS_PER_SEC / 1000);
+      totalTime += stagesTimes[0];
+
+      if (mReport == TrackingReport::Verbose) {
+
+        *mReportStream << std::setw(2) << " - Context initialized in: " << stagesTimes[0] << "ms" << std::endl;
+      }
+    }
+
+    roads.emplace_back();
+    mTracks.emplace_back();
+
+    for (mCurrentIteration = 0; mCurrentIteration < iterationsNum; ++mCurrentIteration) {
+
+      if (mCurrentIteration > 0) {
+
+        markUsedClusters();
+        mPrimaryVertexContext.initializeIteration();
+      }
+
+      if (mReport == TrackingReport::Memory && mCurrentIteration == 0) {
+
+        recordCapacities(vertexOccupancy);
+      }
+
+      /// The tracklets and cells stop as soon as a layer would grow past the enforced budget, the neighbours are
+      /// only checked once found
+      try {
+
+        if (mTrackingParameters.pipelinedExecution) {
+
+          stagesTimes[1] += evaluateTask(&Tracker<IsGPU>::computePipelinedStages,
+              "Pipelined Tracklets and Cells Finding");
+
+        } else {
+
+          stagesTimes[1] += evaluateTask(&Tracker<IsGPU>::computeTracklets, "Tracklets Finding");
+          stagesTimes[2] += evaluateTask(&Tracker<IsGPU>::computeCells, "Cells Finding");
+          stagesTimes[3] += evaluateTask(&Tracker<IsGPU>::findCellsNeighbours, "Neighbours Finding");
+        }
+
+      } catch (const MemoryBudgetExceeded&) {
+
+        isTracked = false;
+      }
+
+      if (isTracked && mReport == TrackingReport::Memory && mCurrentIteration == 0) {
+
+        recordSizes(vertexOccupancy);
+      }
+
+      if (!isTracked || isMemoryBudgetExceeded()) {
+
+        isTracked = false;
+        break;
+      }
+
+      const int firstTrackIndex { static_cast<int>(mTracks.back().size()) };
+
+      stagesTimes[4] += evaluateTask(&Tracker<IsGPU>::findTracks, "Tracks Finding");
+      stagesTimes[5] += evaluateTask(&Tracker<IsGPU>::computeMontecarloLabels, "Computing Montecarlo Labels");
+      totalTime += evaluateTask(&Tracker<IsGPU>::fitTracks, "Tracks Fitting");
+      collectRoads(roads.back(), firstTrackIndex);
+    }
+
+    if (isTracked && mReport != TrackingReport::None) {
+
+      reportVertex(iVertex, stagesTimes, totalTime, vertexOccupancy, roads.back().size());
+    }
+  }
+
+  mCurrentIteration = 0;
+
+  return isTracked;
+}
+
+template<bool IsGPU>
+bool Tracker<IsGPU>::trackEventChunks(const Event& event, const int chunksNum, std::vector<std::vector<Road>>& roads)
+{
+  /// Up to Constants::Memory::MaxPhiSectorsNum chunks the event is cut in phi sectors holding all its vertices. Past
+  /// them, as the phi halos keep a sector from shrinking further, each vertex is tracked alone on phi sectors also cut
+  /// in tan(lambda) slices
+  const int verticesNum { event.getPrimaryVerticesNum() };
+  const bool isSliced { chunksNum > Constants::Memory::MaxPhiSectorsNum };
+  DecompositionParameters chunksParameters { };
+  std::vector<Event> chunkEvents { };
+  std::vector<std::vector<Road>> chunkRoads { };
+  std::vector<std::vector<Track>> tracks(verticesNum);
+  bool isTracked { true };
+  chunksParameters.sectorsNum = std::min(chunksNum, Constants::Memory::MaxPhiSectorsNum);
+  chunksParameters.slicesNum = (chunksNum + Constants::Memory::MaxPhiSectorsNum - 1)
+      / Constants::Memory::MaxPhiSectorsNum;
+  roads.assign(verticesNum, std::vector<Road> { });
+
+  for (int iVertex { 0 }; iVertex < (isSliced ? verticesNum : 1) && isTracked; ++iVertex) {
+
+#if !TRACKINGITSU_GPU_MODE
+    if (isSliced) {
+
+      TrackingUtils::splitVertexChunks(event, iVertex, chunksParameters, chunkEvents, mClustersChunks);
+
+    } else {
+
+      TrackingUtils::splitPhiSectors(event, chunksParameters, chunkEvents, mClustersChunks);
+    }
+#endif
+
+    for (mCurrentChunk = 0; mCurrentChunk < static_cast<int>(chunkEvents.size()) && isTracked; ++mCurrentChunk) {
+
+      /// Every chunk starts from freed arrays, the capacities retained from the layers of the previous chunk would
+      /// otherwise take the budget left to the layers of this one
+      mPrimaryVertexContext.releaseMemory();
+      mPrimaryVertexContext.releaseClustersMemory();
+      isTracked = trackEvent(chunkEvents[mCurrentChunk], chunkRoads);
+
+      for (int iChunkVertex { 0 }; iChunkVertex < static_cast<int>(chunkRoads.size()); ++iChunkVertex) {
+
+        const int iEventVertex { isSliced ? iVertex : iChunkVertex };
+        roads[iEventVertex].insert(roads[iEventVertex].end(), chunkRoads[iChunkVertex].begin(),
+            chunkRoads[iChunkVertex].end());
+        tracks[iEventVertex].insert(tracks[iEventVertex].end(), mTracks[iChunkVertex].begin(),
+            mTracks[iChunkVertex].end());
+      }
+    }
+  }
+
+  mCurrentChunk = Constants::ITS::UnusedIndex;
+  mTracks.swap(tracks);
+
+  return isTracked;
+}
+
+template<bool IsGPU>
+void Tracker<IsGPU>::collectRoads(std::vector<Road>& roads, const int firstTrackIndex)
+{
+  std::vector<Road>& contextRoads { mPrimaryVertexContext.getRoads() };
+
+  if (mCurrentChunk == Constants::ITS::UnusedIndex) {
+
+    roads.insert(roads.end(), contextRoads.begin(), contextRoads.end());
+
+    return;
+  }
+
+  /// A road found in the halo of a chunk is dropped, unless the chunk owns its innermost cluster. The cells of a kept
+  /// road are cleared, as they index the chunk context that the next chunk overwrites
+  for (Road& road : contextRoads) {
+
+    int innermostLayer { 0 };
+
+    while (road[innermostLayer] == Constants::ITS::UnusedIndex) {
+
+      ++innermostLayer;
+    }
+
+    const Cell& innermostCell { mPrimaryVertexContext.getCells()[innermostLayer][road[innermostLayer]] };
+    const Cluster& innermostCluster {
+        mPrimaryVertexContext.getClusters()[innermostLayer][innermostCell.getFirstClusterIndex()] };
+
+    if (mClustersChunks[innermostCluster.clusterId] == mCurrentChunk) {
+
+      roads.push_back(road);
+      roads.back().resetRoad();
+    }
+  }
+
+  std::vector<Track>& tracks { mTracks.back() };
+
+  tracks.erase(std::remove_if(tracks.begin() + firstTrackIndex, tracks.end(), [this](const Track& track) {
+    int innermostLayer { 0 };
+
+    while (track.clusterIds[innermostLayer] == Constants::ITS::UnusedIndex) {
+
+      ++innermostLayer;
+    }
+
+    return mClustersChunks[track.clusterIds[innermostLayer]] != mCurrentChunk;
+  }), tracks.end());
+}
+
+template<bool IsGPU>
+void Tracker<IsGPU>::recordCapacities(VertexOccupancy& vertexOccupancy)
+{
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    vertexOccupancy.clustersSizes[iLayer] = mPrimaryVertexContext.getClusters()[iLayer].size();
+  }
+
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    vertexOccupancy.trackletsCapacities[iLayer] = mPrimaryVertexContext.getTracklets()[iLayer].capacity();
+  }
+#endif
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    vertexOccupancy.cellsCapacities[iLayer] = mPrimaryVertexContext.getCells()[iLayer].capacity();
+  }
+}
+
+template<bool IsGPU>
+void Tracker<IsGPU>::recordSizes(VertexOccupancy& vertexOccupancy)
+{
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+
+    vertexOccupancy.trackletsSizes[iLayer] = mPrimaryVertexContext.getTracklets()[iLayer].size();
+  }
+#endif
 
-      return;
-    }
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    vertexOccupancy.cellsSizes[iLayer] = mPrimaryVertexContext.getCells()[iLayer].size();
+  }
+}
 
-    const float3 &primaryVertex = primaryVertexContext.getPrimaryVertex();
-    const int currentLayerClustersNum { static_cast<int>(primaryVertexContext.getClusters()[iLayer].size()) };
+template<bool IsGPU>
+void Tracker<IsGPU>::reportVertex(const int vertexIndex, const std::array<float, 6>& stagesTimes,
+    const float totalTime, const VertexOccupancy& vertexOccupancy, const std::size_t roadsNum) const
+{
+  std::ostream& reportStream { *mReportStream };
 
-    for (int iCluster { 0 }; iCluster < currentLayerClustersNum; ++iCluster) {
+  if (mReport == TrackingReport::Verbose) {
 
-      const Cluster& currentCluster { primaryVertexContext.getClusters()[iLayer][iCluster] };
+    float vertexTime { totalTime };
 
-      const float tanLambda { (currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate };
-      const float directionZIntersection { tanLambda
-          * (Constants::ITS::LayersRCoordinate()[iLayer + 1] - currentCluster.rCoordinate)
-          + currentCluster.zCoordinate };
+    for (int iStage { 1 }; iStage < static_cast<int>(stagesTimes.size()); ++iStage) {
 
-      const int4 selectedBinsRect { TrackingUtils::getBinsRect(currentCluster, iLayer, directionZIntersection) };
+      vertexTime += stagesTimes[iStage];
+    }
 
-      if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+    reportStream << std::setw(2) << " - Vertex " << vertexIndex + 1 << " completed in: " << vertexTime << "ms"
+        << std::endl;
 
-        continue;
-      }
+  } else if (mReport == TrackingReport::Time) {
 
-      int phiBinsNum { selectedBinsRect.w - selectedBinsRect.y + 1 };
+    float vertexTime { totalTime };
 
-      if (phiBinsNum < 0) {
+    for (int iStage { 0 }; iStage < static_cast<int>(stagesTimes.size()); ++iStage) {
 
-        phiBinsNum += Constants::IndexTable::PhiBins;
-      }
+      reportStream << stagesTimes[iStage] << "\t";
 
-      for (int iPhiBin { selectedBinsRect.y }, iPhiCount { 0 }; iPhiCount < phiBinsNum;
-          iPhiBin = ++iPhiBin == Constants::IndexTable::PhiBins ? 0 : iPhiBin, iPhiCount++) {
+      if (iStage > 0) {
 
-        const int firstBinIndex { IndexTableUtils::getBinIndex(selectedBinsRect.x, iPhiBin) };
-        const int maxBinIndex { firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1 };
-        const int firstRowClusterIndex = primaryVertexContext.getIndexTables()[iLayer][firstBinIndex];
-        const int maxRowClusterIndex = primaryVertexContext.getIndexTables()[iLayer][maxBinIndex];
+        vertexTime += stagesTimes[iStage];
+      }
+    }
 
-        for (int iNextLayerCluster { firstRowClusterIndex }; iNextLayerCluster <= maxRowClusterIndex;
-            ++iNextLayerCluster) {
+    reportStream << vertexTime << std::endl;
 
-          const Cluster& nextCluster { primaryVertexContext.getClusters()[iLayer + 1][iNextLayerCluster] };
+  } else if (mReport == TrackingReport::Memory) {
 
-          const float deltaZ { MATH_ABS(
-              tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) + currentCluster.zCoordinate
-                  - nextCluster.zCoordinate) };
-          const float deltaPhi { MATH_ABS(currentCluster.phiCoordinate - nextCluster.phiCoordinate) };
+    for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
 
-          if (deltaZ < Constants::Thresholds::TrackletMaxDeltaZThreshold()[iLayer]
-              && (deltaPhi < Constants::Thresholds::PhiCoordinateCut
-                  || MATH_ABS(deltaPhi - Constants::Math::TwoPi) < Constants::Thresholds::PhiCoordinateCut)) {
+      reportStream << vertexOccupancy.clustersSizes[iLayer] << "\t";
+    }
 
-            if (iLayer > 0
-                && primaryVertexContext.getTrackletsLookupTable()[iLayer - 1][iCluster]
-                    == Constants::ITS::UnusedIndex) {
+    reportStream << std::endl;
 
-              primaryVertexContext.getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                  primaryVertexContext.getTracklets()[iLayer].size();
-            }
+#if !TRACKINGITSU_GPU_MODE
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-            primaryVertexContext.getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                nextCluster);
-          }
-        }
-      }
+      reportStream << vertexOccupancy.trackletsCapacities[iLayer] << "\t";
     }
-  }
-}
 
-template<>
-void TrackerTraits<false>::computeLayerCells(PrimaryVertexContext& primaryVertexContext)
-{
-  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+    reportStream << std::endl;
 
-    if (primaryVertexContext.getTracklets()[iLayer + 1].empty()
-        || primaryVertexContext.getTracklets()[iLayer].empty()) {
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      return;
+      reportStream << vertexOccupancy.trackletsSizes[iLayer] << "\t";
     }
 
-    const float3 &primaryVertex = primaryVertexContext.getPrimaryVertex();
-    const int currentLayerTrackletsNum { static_cast<int>(primaryVertexContext.getTracklets()[iLayer].size()) };
+    reportStream << std::endl;
+#endif
 
-    for (int iTracklet { 0 }; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
-      const Tracklet& currentTracklet { primaryVertexContext.getTracklets()[iLayer][iTracklet] };
-      const int nextLayerClusterIndex { currentTracklet.secondClusterIndex };
-      const int nextLayerFirstTrackletIndex {
-          primaryVertexContext.getTrackletsLookupTable()[iLayer][nextLayerClusterIndex] };
+      reportStream << vertexOccupancy.cellsCapacities[iLayer] << "\t";
+    }
 
-      if (nextLayerFirstTrackletIndex == Constants::ITS::UnusedIndex) {
+    reportStream << std::endl;
 
-        continue;
-      }
+    for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
-      const Cluster& firstCellCluster { primaryVertexContext.getClusters()[iLayer][currentTracklet.firstClusterIndex] };
-      const Cluster& secondCellCluster {
-          primaryVertexContext.getClusters()[iLayer + 1][currentTracklet.secondClusterIndex] };
-      const float firstCellClusterQuadraticRCoordinate { firstCellCluster.rCoordinate * firstCellCluster.rCoordinate };
-      const float secondCellClusterQuadraticRCoordinate { secondCellCluster.rCoordinate * secondCellCluster.rCoordinate };
-      const float3 firstDeltaVector { secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-          secondCellCluster.yCoordinate - firstCellCluster.yCoordinate, secondCellClusterQuadraticRCoordinate
-              - firstCellClusterQuadraticRCoordinate };
-      const int nextLayerTrackletsNum { static_cast<int>(primaryVertexContext.getTracklets()[iLayer + 1].size()) };
-
-      for (int iNextLayerTracklet { nextLayerFirstTrackletIndex };
-          iNextLayerTracklet < nextLayerTrackletsNum
-              && primaryVertexContext.getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex
-                  == nextLayerClusterIndex; ++iNextLayerTracklet) {
-
-        const Tracklet& nextTracklet { primaryVertexContext.getTracklets()[iLayer + 1][iNextLayerTracklet] };
-        const float deltaTanLambda { std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda) };
-        const float deltaPhi { std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate) };
-
-        if (deltaTanLambda < Constants::Thresholds::CellMaxDeltaTanLambdaThreshold
-            && (deltaPhi < Constants::Thresholds::CellMaxDeltaPhiThreshold
-                || std::abs(deltaPhi - Constants::Math::TwoPi) < Constants::Thresholds::CellMaxDeltaPhiThreshold)) {
-
-          const float averageTanLambda { 0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda) };
-          const float directionZIntersection { -averageTanLambda * firstCellCluster.rCoordinate
-              + firstCellCluster.zCoordinate };
-          const float deltaZ { std::abs(directionZIntersection - primaryVertex.z) };
-
-          if (deltaZ < Constants::Thresholds::CellMaxDeltaZThreshold()[iLayer]) {
-
-            const Cluster& thirdCellCluster {
-                primaryVertexContext.getClusters()[iLayer + 2][nextTracklet.secondClusterIndex] };
-
-            const float thirdCellClusterQuadraticRCoordinate { thirdCellCluster.rCoordinate
-                * thirdCellCluster.rCoordinate };
-
-            const float3 secondDeltaVector { thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate, thirdCellClusterQuadraticRCoordinate
-                    - firstCellClusterQuadraticRCoordinate };
-
-            float3 cellPlaneNormalVector { MathUtils::crossProduct(firstDeltaVector, secondDeltaVector) };
-
-            const float vectorNorm { std::sqrt(
-                cellPlaneNormalVector.x * cellPlaneNormalVector.x + cellPlaneNormalVector.y * cellPlaneNormalVector.y
-                    + cellPlaneNormalVector.z * cellPlaneNormalVector.z) };
-
-            if (vectorNorm < Constants::Math::FloatMinThreshold
-                || std::abs(cellPlaneNormalVector.z) < Constants::Math::FloatMinThreshold) {
-
-              continue;
-            }
-
-            const float inverseVectorNorm { 1.0f / vectorNorm };
-            const float3 normalizedPlaneVector { cellPlaneNormalVector.x * inverseVectorNorm, cellPlaneNormalVector.y
-                * inverseVectorNorm, cellPlaneNormalVector.z * inverseVectorNorm };
-            const float planeDistance { -normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x)
-                - (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y)
-                - normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate };
-            const float normalizedPlaneVectorQuadraticZCoordinate { normalizedPlaneVector.z * normalizedPlaneVector.z };
-            const float cellTrajectoryRadius { std::sqrt(
-                (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z)
-                    / (4.0f * normalizedPlaneVectorQuadraticZCoordinate)) };
-            const float2 circleCenter { -0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z, -0.5f
-                * normalizedPlaneVector.y / normalizedPlaneVector.z };
-            const float distanceOfClosestApproach { std::abs(
-                cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y)) };
-
-            if (distanceOfClosestApproach
-                > Constants::Thresholds::CellMaxDistanceOfClosestApproachThreshold()[iLayer]) {
-
-              continue;
-            }
-
-            const float cellTrajectoryCurvature { 1.0f / cellTrajectoryRadius };
-
-            if (iLayer > 0
-                && primaryVertexContext.getCellsLookupTable()[iLayer - 1][iTracklet] == Constants::ITS::UnusedIndex) {
-
-              primaryVertexContext.getCellsLookupTable()[iLayer - 1][iTracklet] =
-                  primaryVertexContext.getCells()[iLayer].size();
-            }
-
-            primaryVertexContext.getCells()[iLayer].emplace_back(currentTracklet.firstClusterIndex,
-                nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex, iTracklet, iNextLayerTracklet,
-                normalizedPlaneVector, cellTrajectoryCurvature);
-          }
-        }
-      }
+      reportStream << vertexOccupancy.cellsSizes[iLayer] << "\t";
     }
+
+    reportStream << std::endl;
+    reportStream << roadsNum << std::endl;
   }
 }
+
+template<bool IsGPU>
+bool Tracker<IsGPU>::isMemoryBudgetExceeded() const
+{
+#if TRACKINGITSU_GPU_MODE
+  return false;
+#else
+  return mEnforcedMemoryBudget > 0 && mPrimaryVertexContext.getMemorySize() > mEnforcedMemoryBudget;
 #endif
+}
 
 template<bool IsGPU>
-Tracker<IsGPU>::Tracker()
+std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksVerbose(const Event& event)
 {
-  // Nothing to do
+  return clustersToTracksReport(event, TrackingReport::Verbose, std::cout);
 }
 
 template<bool IsGPU>
-std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracks(const Event& event)
+std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksMemoryBenchmark(
+    const Event& event, std::ofstream & memoryBenchmarkOutputStream)
 {
-  const int verticesNum { event.getPrimaryVerticesNum() };
-  std::vector<std::vector<Road>> roads { };
-  roads.reserve(verticesNum);
+  return clustersToTracksReport(event, TrackingReport::Memory, memoryBenchmarkOutputStream);
+}
 
-  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+template<bool IsGPU>
+std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksTimeBenchmark(
+    const Event& event, std::ofstream& timeBenchmarkOutputStream)
+{
+  return clustersToTracksReport(event, TrackingReport::Time, timeBenchmarkOutputStream);
+}
 
-    mPrimaryVertexContext.initialize(event, iVertex);
+template<bool IsGPU>
+std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksReport(const Event& event,
+    const TrackingReport report, std::ostream& reportStream)
+{
+  mReport = report;
+  mReportStream = &reportStream;
 
-    computeTracklets();
-    computeCells();
-    findCellsNeighbours();
-    findTracks();
-    computeMontecarloLabels();
+  std::vector<std::vector<Road>> roads { clustersToTracks(event) };
 
-    roads.emplace_back(mPrimaryVertexContext.getRoads());
-  }
+  mReport = TrackingReport::None;
+  mReportStream = nullptr;
 
   return roads;
 }
 
 template<bool IsGPU>
-std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksVerbose(const Event& event)
+void Tracker<IsGPU>::selectIndexTables(const Event& event)
 {
-  const int verticesNum { event.getPrimaryVerticesNum() };
-  std::vector<std::vector<Road>> roads { };
-  roads.reserve(verticesNum);
-
-  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
-
-    clock_t t1 { }, t2 { };
-    float diff { };
-
-    t1 = clock();
-
-    mPrimaryVertexContext.initialize(event, iVertex);
-
-    t2 = clock();
-    diff = ((float) t2 - (float) t1) / (CLOCKS_PER_SEC / 1000);
-    std::cout << std::setw(2) << " - Context initialized in: " << diff << "ms" << std::endl;
-
-    evaluateTask(&Tracker<IsGPU>::computeTracklets, "Tracklets Finding");
-    evaluateTask(&Tracker<IsGPU>::computeCells, "Cells Finding");
-    evaluateTask(&Tracker<IsGPU>::findCellsNeighbours, "Neighbours Finding");
-    evaluateTask(&Tracker<IsGPU>::findTracks, "Tracks Finding");
-    evaluateTask(&Tracker<IsGPU>::computeMontecarloLabels, "Computing Montecarlo Labels");
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-    t2 = clock();
-    diff = ((float) t2 - (float) t1) / (CLOCKS_PER_SEC / 1000);
-    std::cout << std::setw(2) << " - Vertex " << iVertex + 1 << " completed in: " << diff << "ms" << std::endl;
+    const int clustersNum { event.getLayer(iLayer + 1).getClustersSize() };
 
-    roads.emplace_back(mPrimaryVertexContext.getRoads());
+    mPrimaryVertexContext.getIndexTableGranularities()[iLayer] = mTrackingParameters.getIndexTableGranularity(iLayer,
+        clustersNum);
+    mPrimaryVertexContext.getIndexTableSearchEngines()[iLayer] = mTrackingParameters.getIndexTableSearchEngine(iLayer,
+        clustersNum);
   }
-
-  return roads;
+#endif
 }
 
 template<bool IsGPU>
-std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksMemoryBenchmark(
-    const Event& event, std::ofstream & memoryBenchmarkOutputStream)
+void Tracker<IsGPU>::computeTracklets()
 {
-  const int verticesNum { event.getPrimaryVerticesNum() };
-  std::vector<std::vector<Road>> roads { };
-  roads.reserve(verticesNum);
+#if TRACKINGITSU_GPU_MODE
+  Trait::computeLayerTracklets(mPrimaryVertexContext);
+#else
+  if (mTrackingParameters.phiSectorsTraversal) {
 
-  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+    Trait::computePhiSectorsTracklets(mPrimaryVertexContext);
 
-    mPrimaryVertexContext.initialize(event, iVertex);
+    if (mCurrentIteration == 0) {
 
-    for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+      for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      memoryBenchmarkOutputStream << mPrimaryVertexContext.getClusters()[iLayer].size() << "\t";
+        mPrimaryVertexContext.sampleTrackletsOccupancy(iLayer);
+      }
     }
 
-    memoryBenchmarkOutputStream << std::endl;
+  } else {
 
-#if !TRACKINGITSU_GPU_MODE
     for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      memoryBenchmarkOutputStream << mPrimaryVertexContext.getTracklets()[iLayer].capacity() << "\t";
+      findLayerTracklets(iLayer);
     }
+  }
+#endif
 
-    memoryBenchmarkOutputStream << std::endl;
+  if (mTrackingParameters.trackletsPruning) {
 
-    computeTracklets();
+    pruneTracklets();
+  }
+}
 
-    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
+template<bool IsGPU>
+void Tracker<IsGPU>::findLayerTracklets(const int iLayer)
+{
+#if !TRACKINGITSU_GPU_MODE
+  Trait::computeLayerTracklets(mPrimaryVertexContext, iLayer);
 
-      memoryBenchmarkOutputStream << mPrimaryVertexContext.getTracklets()[iLayer].size() << "\t";
-    }
+  if (mCurrentIteration == 0) {
 
-    memoryBenchmarkOutputStream << std::endl;
+    mPrimaryVertexContext.sampleTrackletsOccupancy(iLayer);
+  }
 #endif
+}
 
-    for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+template<bool IsGPU>
+void Tracker<IsGPU>::pruneTracklets()
+{
+#if !TRACKINGITSU_GPU_MODE
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      memoryBenchmarkOutputStream << mPrimaryVertexContext.getCells()[iLayer].capacity() << "\t";
-    }
+    Trait::pruneLayerTracklets(mPrimaryVertexContext, iLayer);
+  }
+#endif
+}
+
+template<bool IsGPU>
+void Tracker<IsGPU>::computeCells()
+{
+#if TRACKINGITSU_GPU_MODE
+  Trait::computeLayerCells(mPrimaryVertexContext);
+#else
+  if (mTrackingParameters.phiSectorsTraversal) {
 
-    memoryBenchmarkOutputStream << std::endl;
+    Trait::computePhiSectorsCells(mPrimaryVertexContext);
+
+  } else {
+
+    Trait::computeLayerCells(mPrimaryVertexContext);
+  }
 
-    computeCells();
+  if (mCurrentIteration == 0) {
 
     for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
-      memoryBenchmarkOutputStream << mPrimaryVertexContext.getCells()[iLayer].size() << "\t";
+      mPrimaryVertexContext.sampleCellsOccupancy(iLayer);
     }
+  }
+#endif
+}
 
-    memoryBenchmarkOutputStream << std::endl;
+template<bool IsGPU>
+void Tracker<IsGPU>::findCellsNeighbours()
+{
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad - 1; ++iLayer) {
 
-    findCellsNeighbours();
-    findTracks();
-    computeMontecarloLabels();
+    findLayerCellsNeighbours(iLayer);
+  }
 
-    roads.emplace_back(mPrimaryVertexContext.getRoads());
+  if (mTrackingParameters.cellsAutomatonEvolution) {
 
-    memoryBenchmarkOutputStream << mPrimaryVertexContext.getRoads().size() << std::endl;
+    mCellsAutomaton.evolve(mPrimaryVertexContext, mTrackingParameters.pipelinedExecution);
   }
 
-  return roads;
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+    mPrimaryVertexContext.sortCellsByLevel(iLayer);
+  }
 }
 
 template<bool IsGPU>
-std::vector<std::vector<Road>> Tracker<IsGPU>::clustersToTracksTimeBenchmark(
-    const Event& event, std::ofstream& timeBenchmarkOutputStream)
+void Tracker<IsGPU>::findLayerCellsNeighbours(const int iLayer)
 {
-  const int verticesNum = event.getPrimaryVerticesNum();
-  std::vector<std::vector<Road>> roads;
-  roads.reserve(verticesNum);
+  if (mPrimaryVertexContext.getCells()[iLayer + 1].empty()
+      || mPrimaryVertexContext.getCellsLookupTable()[iLayer].empty()) {
 
-  for (int iVertex = 0; iVertex < verticesNum; ++iVertex) {
+    return;
+  }
 
-    clock_t t1, t2;
-    float diff, total = .0f;
+  int layerCellsNum { static_cast<int>(mPrimaryVertexContext.getCells()[iLayer].size()) };
 
-    t1 = clock();
+  for (int iCell { 0 }; iCell < layerCellsNum; ++iCell) {
 
-    mPrimaryVertexContext.initialize(event, iVertex);
+    const Cell& currentCell { mPrimaryVertexContext.getCells()[iLayer][iCell] };
+    const int nextLayerTrackletIndex { currentCell.getSecondTrackletIndex() };
+    const int nextLayerFirstCellIndex { mPrimaryVertexContext.getCellsLookupTable()[iLayer][nextLayerTrackletIndex] };
+    const int nextLayerMaxCellIndex { mPrimaryVertexContext.getCellsLookupTable()[iLayer][nextLayerTrackletIndex
+        + 1] };
 
-    t2 = clock();
-    diff = ((float) t2 - (float) t1) / (CLOCKS_PER_SEC / 1000);
-    total += diff;
-    timeBenchmarkOutputStream << diff << "\t";
+    if (nextLayerFirstCellIndex < nextLayerMaxCellIndex) {
 
-    total += evaluateTask(&Tracker<IsGPU>::computeTracklets, nullptr, timeBenchmarkOutputStream);
-    total += evaluateTask(&Tracker<IsGPU>::computeCells, nullptr, timeBenchmarkOutputStream);
-    total += evaluateTask(&Tracker<IsGPU>::findCellsNeighbours, nullptr, timeBenchmarkOutputStream);
-    total += evaluateTask(&Tracker<IsGPU>::findTracks, nullptr, timeBenchmarkOutputStream);
-    total += evaluateTask(&Tracker<IsGPU>::computeMontecarloLabels, nullptr, timeBenchmarkOutputStream);
+      const int nextLayerCellsNum { static_cast<int>(mPrimaryVertexContext.getCells()[iLayer + 1].size()) };
+      mPrimaryVertexContext.getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
 
-    timeBenchmarkOutputStream << total << std::endl;
+      for (int iNextLayerCell { nextLayerFirstCellIndex }; iNextLayerCell < nextLayerMaxCellIndex;
+          ++iNextLayerCell) {
 
-    roads.emplace_back(mPrimaryVertexContext.getRoads());
-  }
+        Cell& nextCell { mPrimaryVertexContext.getCells()[iLayer + 1][iNextLayerCell] };
+        const float3 currentCellNormalVector { currentCell.getNormalVectorCoordinates() };
+        const float3 nextCellNormalVector { nextCell.getNormalVectorCoordinates() };
+        const float3 normalVectorsDeltaVector { currentCellNormalVector.x - nextCellNormalVector.x,
+            currentCellNormalVector.y - nextCellNormalVector.y, currentCellNormalVector.z - nextCellNormalVector.z };
 
-  return roads;
-}
+        const float deltaNormalVectorsModulus { (normalVectorsDeltaVector.x * normalVectorsDeltaVector.x)
+            + (normalVectorsDeltaVector.y * normalVectorsDeltaVector.y)
+            + (normalVectorsDeltaVector.z * normalVectorsDeltaVector.z) };
+        const float deltaCurvature { std::abs(currentCell.getCurvature() - nextCell.getCurvature()) };
 
-template<bool IsGPU>
-void Tracker<IsGPU>::computeTracklets()
-{
-  Trait::computeLayerTracklets(mPrimaryVertexContext);
-}
+        if (deltaNormalVectorsModulus < Constants::Thresholds::NeighbourCellMaxNormalVectorsDelta[iLayer]
+            && deltaCurvature < Constants::Thresholds::NeighbourCellMaxCurvaturesDelta[iLayer]) {
 
-template<bool IsGPU>
-void Tracker<IsGPU>::computeCells()
-{
-  Trait::computeLayerCells(mPrimaryVertexContext);
+          mPrimaryVertexContext.getCellsNeighbours()[iLayer][iNextLayerCell].push_back(iCell);
+
+          if (mTrackingParameters.cellsAutomatonEvolution) {
+
+            continue;
+          }
+
+          const int currentCellLevel { currentCell.getLevel() };
+
+          if (currentCellLevel >= nextCell.getLevel()) {
+
+            nextCell.setLevel(currentCellLevel + 1);
+          }
+        }
+      }
+    }
+  }
 }
 
 template<bool IsGPU>
-void Tracker<IsGPU>::findCellsNeighbours()
+void Tracker<IsGPU>::computePipelinedStages()
 {
-  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad - 1; ++iLayer) {
+#if TRACKINGITSU_GPU_MODE
+  computeTracklets();
+  computeCells();
+  findCellsNeighbours();
+#else
+  /// Each stage only waits for the layers it reads: the cells of layer i need the tracklets of layers i and i + 1,
+  /// the neighbours of layer i need the cells of layers i and i + 1 and the final levels of layer i, which are
+  /// written by the neighbours of layer i - 1. The pruning of layer i reads the tracklets of layers i - 1 and i + 1
+  /// and rewrites the lookup table of layer i - 1, so it also waits for the pruning of layer i - 1.
+  std::array<std::shared_future<void>, Constants::ITS::TrackletsPerRoad> trackletsTasks;
+  std::array<std::shared_future<void>, Constants::ITS::CellsPerRoad> cellsTasks;
+  std::array<std::shared_future<void>, Constants::ITS::CellsPerRoad - 1> neighboursTasks;
 
-    if (mPrimaryVertexContext.getCells()[iLayer + 1].empty()
-        || mPrimaryVertexContext.getCellsLookupTable()[iLayer].empty()) {
+  for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      continue;
-    }
+    trackletsTasks[iLayer] = std::async(std::launch::async, [this, iLayer]() {
+      findLayerTracklets(iLayer);
+    }).share();
+  }
 
-    int layerCellsNum { static_cast<int>(mPrimaryVertexContext.getCells()[iLayer].size()) };
+  if (mTrackingParameters.trackletsPruning) {
 
-    for (int iCell { 0 }; iCell < layerCellsNum; ++iCell) {
+    std::array<std::shared_future<void>, Constants::ITS::TrackletsPerRoad> pruningTasks;
 
-      const Cell& currentCell { mPrimaryVertexContext.getCells()[iLayer][iCell] };
-      const int nextLayerTrackletIndex { currentCell.getSecondTrackletIndex() };
-      const int nextLayerFirstCellIndex { mPrimaryVertexContext.getCellsLookupTable()[iLayer][nextLayerTrackletIndex] };
+    for (int iLayer { 0 }; iLayer < Constants::ITS::TrackletsPerRoad; ++iLayer) {
 
-      if (nextLayerFirstCellIndex != Constants::ITS::UnusedIndex
-          && mPrimaryVertexContext.getCells()[iLayer + 1][nextLayerFirstCellIndex].getFirstTrackletIndex()
-              == nextLayerTrackletIndex) {
+      const std::shared_future<void> currentLayerTask { trackletsTasks[iLayer] };
+      const std::shared_future<void> previousLayerTask { iLayer > 0 ? pruningTasks[iLayer - 1] : trackletsTasks[0] };
+      const std::shared_future<void> nextLayerTask {
+          iLayer < Constants::ITS::TrackletsPerRoad - 1 ? trackletsTasks[iLayer + 1] : trackletsTasks[iLayer] };
+
+      pruningTasks[iLayer] = std::async(std::launch::async,
+          [this, iLayer, currentLayerTask, previousLayerTask, nextLayerTask]() {
+            currentLayerTask.get();
+            nextLayerTask.get();
+            previousLayerTask.get();
+            Trait::pruneLayerTracklets(mPrimaryVertexContext, iLayer);
+          }).share();
+    }
 
-        const int nextLayerCellsNum { static_cast<int>(mPrimaryVertexContext.getCells()[iLayer + 1].size()) };
-        mPrimaryVertexContext.getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
+    trackletsTasks = pruningTasks;
+  }
 
-        for (int iNextLayerCell { nextLayerFirstCellIndex };
-            iNextLayerCell < nextLayerCellsNum
-                && mPrimaryVertexContext.getCells()[iLayer + 1][iNextLayerCell].getFirstTrackletIndex()
-                    == nextLayerTrackletIndex; ++iNextLayerCell) {
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
 
-          Cell& nextCell { mPrimaryVertexContext.getCells()[iLayer + 1][iNextLayerCell] };
-          const float3 currentCellNormalVector { currentCell.getNormalVectorCoordinates() };
-          const float3 nextCellNormalVector { nextCell.getNormalVectorCoordinates() };
-          const float3 normalVectorsDeltaVector { currentCellNormalVector.x - nextCellNormalVector.x,
-              currentCellNormalVector.y - nextCellNormalVector.y, currentCellNormalVector.z - nextCellNormalVector.z };
+    cellsTasks[iLayer] = std::async(std::launch::async, [this, iLayer, &trackletsTasks]() {
+      trackletsTasks[iLayer].get();
+      trackletsTasks[iLayer + 1].get();
+      Trait::computeLayerCells(mPrimaryVertexContext, iLayer);
 
-          const float deltaNormalVectorsModulus { (normalVectorsDeltaVector.x * normalVectorsDeltaVector.x)
-              + (normalVectorsDeltaVector.y * normalVectorsDeltaVector.y)
-              + (normalVectorsDeltaVector.z * normalVectorsDeltaVector.z) };
-          const float deltaCurvature { std::abs(currentCell.getCurvature() - nextCell.getCurvature()) };
+      if (mCurrentIteration == 0) {
 
-          if (deltaNormalVectorsModulus < Constants::Thresholds::NeighbourCellMaxNormalVectorsDelta[iLayer]
-              && deltaCurvature < Constants::Thresholds::NeighbourCellMaxCurvaturesDelta[iLayer]) {
+        mPrimaryVertexContext.sampleCellsOccupancy(iLayer);
+      }
+    }).share();
+  }
 
-            mPrimaryVertexContext.getCellsNeighbours()[iLayer][iNextLayerCell].push_back(iCell);
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad - 1; ++iLayer) {
 
-            const int currentCellLevel { currentCell.getLevel() };
+    const std::shared_future<void> previousLayerTask { iLayer > 0 ? neighboursTasks[iLayer - 1] : cellsTasks[0] };
 
-            if (currentCellLevel >= nextCell.getLevel()) {
+    neighboursTasks[iLayer] = std::async(std::launch::async, [this, iLayer, &cellsTasks, previousLayerTask]() {
+      cellsTasks[iLayer].get();
+      cellsTasks[iLayer + 1].get();
+      previousLayerTask.get();
+      findLayerCellsNeighbours(iLayer);
 
-              nextCell.setLevel(currentCellLevel + 1);
-            }
-          }
-        }
+      if (mTrackingParameters.cellsAutomatonEvolution) {
+
+        return;
+      }
+
+      if (iLayer == 0) {
+
+        mPrimaryVertexContext.sortCellsByLevel(iLayer);
       }
+
+      mPrimaryVertexContext.sortCellsByLevel(iLayer + 1);
+    }).share();
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad - 1; ++iLayer) {
+
+    neighboursTasks[iLayer].get();
+  }
+
+  if (mTrackingParameters.cellsAutomatonEvolution) {
+
+    mCellsAutomaton.evolve(mPrimaryVertexContext, true);
+
+    for (int iLayer { 0 }; iLayer < Constants::ITS::CellsPerRoad; ++iLayer) {
+
+      mPrimaryVertexContext.sortCellsByLevel(iLayer);
     }
   }
+#endif
 }
 
 template<bool IsGPU>
 void Tracker<IsGPU>::findTracks()
 {
-  for (int iLevel { Constants::ITS::CellsPerRoad }; iLevel >= Constants::Thresholds::CellsMinLevel; --iLevel) {
+  const int cellsMinimumLevel { mTrackingParameters.cellsMinimumLevel[mCurrentIteration] };
+
+  for (int iLevel { Constants::ITS::CellsPerRoad }; iLevel >= cellsMinimumLevel; --iLevel) {
 
     const int minimumLevel { iLevel - 1 };
+    const int levelFirstRoadIndex { static_cast<int>(mPrimaryVertexContext.getRoads().size()) };
 
     for (int iLayer { Constants::ITS::CellsPerRoad - 1 }; iLayer >= minimumLevel; --iLayer) {
 
-      const int levelCellsNum { static_cast<int>(mPrimaryVertexContext.getCells()[iLayer].size()) };
+      const std::vector<int>& levelsIndexes { mPrimaryVertexContext.getCellsLevelsIndexes()[iLayer] };
+      const int levelLastIndex { mPrimaryVertexContext.getCellsLevelsLookupTable()[iLayer][iLevel + 1] };
 
-      for (int iCell { 0 }; iCell < levelCellsNum; ++iCell) {
+      for (int iLevelCell { mPrimaryVertexContext.getCellsLevelsLookupTable()[iLayer][iLevel] };
+          iLevelCell < levelLastIndex; ++iLevelCell) {
 
+        const int iCell { levelsIndexes[iLevelCell] };
         Cell& currentCell { mPrimaryVertexContext.getCells()[iLayer][iCell] };
 
+        /// The cells of the roads found at the previous levels have been reset to level 0
         if (currentCell.getLevel() != iLevel) {
 
           continue;
         }
 
-        mPrimaryVertexContext.getRoads().emplace_back(iLayer, iCell);
+        traverseCellsTree(iCell, iLayer);
+      }
+    }
 
-        const int cellNeighboursNum {
-            static_cast<int>(mPrimaryVertexContext.getCellsNeighbours()[iLayer - 1][iCell].size()) };
-        bool isFirstValidNeighbour = true;
+    if (iLevel > cellsMinimumLevel) {
 
-        for (int iNeighbourCell { 0 }; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+      /// The cells of the roads found at this level can not seed shorter roads at the next ones
+      const int roadsNum { static_cast<int>(mPrimaryVertexContext.getRoads().size()) };
 
-          const int neighbourCellId = mPrimaryVertexContext.getCellsNeighbours()[iLayer - 1][iCell][iNeighbourCell];
-          const Cell& neighbourCell = mPrimaryVertexContext.getCells()[iLayer - 1][neighbourCellId];
+      for (int iRoad { levelFirstRoadIndex }; iRoad < roadsNum; ++iRoad) {
 
-          if (iLevel - 1 != neighbourCell.getLevel()) {
+        Road& currentRoad { mPrimaryVertexContext.getRoads()[iRoad] };
 
-            continue;
+        for (int iCell { 0 }; iCell < Constants::ITS::CellsPerRoad; ++iCell) {
+
+          if (currentRoad[iCell] != Constants::ITS::UnusedIndex) {
+
+            mPrimaryVertexContext.getCells()[iCell][currentRoad[iCell]].setLevel(0);
           }
+        }
+      }
+    }
+  }
+}
+
+template<bool IsGPU>
+void Tracker<IsGPU>::traverseCellsTree(const int seedCellId, const int seedLayerId)
+{
+  /// Depth-first visit of the cells tree with an explicit stack, the road under construction holds the cells of the
+  /// current path. Every further valid neighbour of a cell stores the current road and continues on it, the cells of
+  /// the new branch overwriting those of the previous one; the branches of the seed cell restart from the seed alone.
+  std::array<int, Constants::ITS::CellsPerRoad> pathCellIds;
+  std::array<int, Constants::ITS::CellsPerRoad> pathNeighbourIndexes;
+  std::array<bool, Constants::ITS::CellsPerRoad> pathHasValidNeighbour;
+  Road currentRoad { seedLayerId, seedCellId };
+  int pathDepth { 0 };
 
-          if (isFirstValidNeighbour) {
+  pathCellIds[0] = seedCellId;
+  pathNeighbourIndexes[0] = 0;
+  pathHasValidNeighbour[0] = false;
 
-            isFirstValidNeighbour = false;
+  while (pathDepth >= 0) {
 
-          } else {
+    const int currentLayerId { seedLayerId - pathDepth };
+    const int currentCellLevel { mPrimaryVertexContext.getCells()[currentLayerId][pathCellIds[pathDepth]].getLevel() };
+    int neighbourCellId { Constants::ITS::UnusedIndex };
 
-            mPrimaryVertexContext.getRoads().emplace_back(iLayer, iCell);
-          }
+    if (currentCellLevel > 1) {
+
+      const std::vector<int>& cellNeighbours {
+          mPrimaryVertexContext.getCellsNeighbours()[currentLayerId - 1][pathCellIds[pathDepth]] };
+      const int cellNeighboursNum { static_cast<int>(cellNeighbours.size()) };
 
-          traverseCellsTree(neighbourCellId, iLayer - 1);
+      while (pathNeighbourIndexes[pathDepth] < cellNeighboursNum) {
+
+        const int candidateCellId { cellNeighbours[pathNeighbourIndexes[pathDepth]++] };
+
+        if (mPrimaryVertexContext.getCells()[currentLayerId - 1][candidateCellId].getLevel()
+            == currentCellLevel - 1) {
+
+          neighbourCellId = candidateCellId;
+          break;
         }
+      }
+    }
+
+    if (neighbourCellId == Constants::ITS::UnusedIndex) {
+
+      --pathDepth;
+      continue;
+    }
+
+    if (pathHasValidNeighbour[pathDepth]) {
+
+      mPrimaryVertexContext.getRoads().push_back(currentRoad);
 
-        //TODO: crosscheck for short track iterations
-        //currentCell.setLevel(0);
+      if (pathDepth == 0) {
+
+        currentRoad = Road { seedLayerId, seedCellId };
       }
+
+    } else {
+
+      pathHasValidNeighbour[pathDepth] = true;
     }
+
+    currentRoad.addCell(currentLayerId - 1, neighbourCellId);
+
+    ++pathDepth;
+    pathCellIds[pathDepth] = neighbourCellId;
+    pathNeighbourIndexes[pathDepth] = 0;
+    pathHasValidNeighbour[pathDepth] = false;
   }
+
+  mPrimaryVertexContext.getRoads().push_back(currentRoad);
 }
 
 template<bool IsGPU>
-void Tracker<IsGPU>::traverseCellsTree(const int currentCellId, const int currentLayerId)
+void Tracker<IsGPU>::markUsedClusters()
 {
-  Cell& currentCell { mPrimaryVertexContext.getCells()[currentLayerId][currentCellId] };
-  const int currentCellLevel = currentCell.getLevel();
-
-  mPrimaryVertexContext.getRoads().back().addCell(currentLayerId, currentCellId);
+#if !TRACKINGITSU_GPU_MODE
+  const int roadsNum { static_cast<int>(mPrimaryVertexContext.getRoads().size()) };
 
-  if (currentLayerId > 0) {
+  for (int iRoad { 0 }; iRoad < roadsNum; ++iRoad) {
 
-    const int cellNeighboursNum {
-        static_cast<int>(mPrimaryVertexContext.getCellsNeighbours()[currentLayerId - 1][currentCellId].size()) };
-    bool isFirstValidNeighbour = true;
+    Road& currentRoad { mPrimaryVertexContext.getRoads()[iRoad] };
 
-    for (int iNeighbourCell { 0 }; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+    for (int iCell { 0 }; iCell < Constants::ITS::CellsPerRoad; ++iCell) {
 
-      const int neighbourCellId =
-          mPrimaryVertexContext.getCellsNeighbours()[currentLayerId - 1][currentCellId][iNeighbourCell];
-      const Cell& neighbourCell = mPrimaryVertexContext.getCells()[currentLayerId - 1][neighbourCellId];
+      const int currentCellIndex { currentRoad[iCell] };
 
-      if (currentCellLevel - 1 != neighbourCell.getLevel()) {
+      if (currentCellIndex == Constants::ITS::UnusedIndex) {
 
         continue;
       }
 
-      if (isFirstValidNeighbour) {
-
-        isFirstValidNeighbour = false;
+      const Cell& currentCell { mPrimaryVertexContext.getCells()[iCell][currentCellIndex] };
 
-      } else {
+      mPrimaryVertexContext.getUsedClustersTable()[iCell][currentCell.getFirstClusterIndex()] = true;
+      mPrimaryVertexContext.getUsedClustersTable()[iCell + 1][currentCell.getSecondClusterIndex()] = true;
+      mPrimaryVertexContext.getUsedClustersTable()[iCell + 2][currentCell.getThirdClusterIndex()] = true;
+    }
+  }
+#endif
+}
 
-        mPrimaryVertexContext.getRoads().push_back(mPrimaryVertexContext.getRoads().back());
-      }
+template<bool IsGPU>
+void Tracker<IsGPU>::fitTracks()
+{
+  if (!mTrackingParameters.tracksFitting) {
 
-      traverseCellsTree(neighbourCellId, currentLayerId - 1);
-    }
+    return;
   }
 
-  //TODO: crosscheck for short track iterations
-  //currentCell.setLevel(0);
+  mTrackFitter.fitRoads(mPrimaryVertexContext, mTracks.back());
 }
 
 template<bool IsGPU>
@@ -575,6 +1392,12 @@ void Tracker<IsGPU>::computeMontecarloLabels()
 {
 /// Moore’s Voting Algorithm
 
+  if (!mTrackingParameters.montecarloLabels) {
+
+    return;
+  }
+
+  const Event& event { mPrimaryVertexContext.getEvent() };
   int roadsNum { static_cast<int>(mPrimaryVertexContext.getRoads().size()) };
 
   for (int iRoad { 0 }; iRoad < roadsNum; ++iRoad) {
@@ -605,12 +1428,12 @@ void Tracker<IsGPU>::computeMontecarloLabels()
 
       if (isFirstRoadCell) {
 
-        maxOccurrencesValue =
-            mPrimaryVertexContext.getClusters()[iCell][currentCell.getFirstClusterIndex()].monteCarloId;
+        maxOccurrencesValue = event.getMonteCarloId(
+            mPrimaryVertexContext.getClusters()[iCell][currentCell.getFirstClusterIndex()].clusterId);
         count = 1;
 
-        const int secondMonteCarlo {
-          mPrimaryVertexContext.getClusters()[iCell + 1][currentCell.getSecondClusterIndex()].monteCarloId };
+        const int secondMonteCarlo { event.getMonteCarloId(
+            mPrimaryVertexContext.getClusters()[iCell + 1][currentCell.getSecondClusterIndex()].clusterId) };
 
         if (secondMonteCarlo == maxOccurrencesValue) {
 
@@ -626,8 +1449,8 @@ void Tracker<IsGPU>::computeMontecarloLabels()
         isFirstRoadCell = false;
       }
 
-      const int currentMonteCarlo {
-        mPrimaryVertexContext.getClusters()[iCell + 2][currentCell.getThirdClusterIndex()].monteCarloId };
+      const int currentMonteCarlo { event.getMonteCarloId(
+          mPrimaryVertexContext.getClusters()[iCell + 2][currentCell.getThirdClusterIndex()].clusterId) };
 
       if (currentMonteCarlo == maxOccurrencesValue) {
 
@@ -654,13 +1477,13 @@ void Tracker<IsGPU>::computeMontecarloLabels()
 template<bool IsGPU>
 float Tracker<IsGPU>::evaluateTask(void (Tracker<IsGPU>::*task)(void), const char *taskName)
 {
-  return evaluateTask(task, taskName, std::cout);
-}
+  if (mReport == TrackingReport::None) {
+
+    (this->*task)();
+
+    return 0.f;
+  }
 
-template<bool IsGPU>
-float Tracker<IsGPU>::evaluateTask(void (Tracker<IsGPU>::*task)(void), const char *taskName,
-    std::ostream& ostream)
-{
   clock_t t1, t2;
   float diff;
 
@@ -671,13 +1494,9 @@ float Tracker<IsGPU>::evaluateTask(void (Tracker<IsGPU>::*task)(void), const cha
   t2 = clock();
   diff = ((float) t2 - (float) t1) / (CLOCKS_PER_SEC / 1000);
 
-  if (taskName == nullptr) {
-
-    ostream << diff << "\t";
-
-  } else {
+  if (mReport == TrackingReport::Verbose) {
 
-    ostream << std::setw(2) << " - " << taskName << " completed in: " << diff << "ms" << std::endl;
+    *mReportStream << std::setw(2) << " - " << taskName << " completed in: " << diff << "ms" << std::endl;
   }
 
   return diff;
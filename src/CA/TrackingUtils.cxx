@@ -14,7 +14,10 @@
 
 #include "ITSReconstruction/CA/TrackingUtils.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 
 #include "ITSReconstruction/CA/Constants.h"
 #include "ITSReconstruction/CA/IndexTableUtils.h"
@@ -27,6 +30,24 @@ namespace ITS
 namespace CA
 {
 
+#if !TRACKINGITSU_GPU_MODE
+namespace
+{
+
+/// Whether a cluster of the given phi coordinate, owned by the sector clusterSector, lies in the sector iSector or in
+/// one of its halos
+bool isInPhiSector(const float phiCoordinate, const int clusterSector, const int iSector, const float sectorPhiWidth,
+    const float haloPhiWidth)
+{
+  const float distanceBefore { MathUtils::getNormalizedPhiCoordinate(iSector * sectorPhiWidth - phiCoordinate) };
+  const float distanceAfter { MathUtils::getNormalizedPhiCoordinate(phiCoordinate - (iSector + 1) * sectorPhiWidth) };
+
+  return iSector == clusterSector || distanceBefore < haloPhiWidth || distanceAfter < haloPhiWidth;
+}
+
+}
+#endif
+
 GPU_DEVICE const int4 TrackingUtils::getBinsRect(const Cluster& currentCluster, const int layerIndex,
     const float directionZIntersection)
 {
@@ -47,6 +68,157 @@ GPU_DEVICE const int4 TrackingUtils::getBinsRect(const Cluster& currentCluster,
       IndexTableUtils::getPhiBinIndex(MathUtils::getNormalizedPhiCoordinate(phiRangeMax)) };
 }
 
+#if !TRACKINGITSU_GPU_MODE
+void TrackingUtils::splitPhiSectors(const Event& event, const DecompositionParameters& decompositionParameters,
+    std::vector<Event>& sectorEvents, std::vector<int>& clustersSectors)
+{
+  /// The sectors are cut in the azimuth around the mean transverse position of the vertices
+  const int sectorsNum { decompositionParameters.sectorsNum };
+  const int verticesNum { event.getPrimaryVerticesNum() };
+  const float sectorPhiWidth { Constants::Math::TwoPi / sectorsNum };
+  float2 transverseOrigin { 0.f, 0.f };
+
+  sectorEvents.clear();
+  clustersSectors.clear();
+
+  for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+
+    transverseOrigin.x += event.getPrimaryVertex(iVertex).x / verticesNum;
+    transverseOrigin.y += event.getPrimaryVertex(iVertex).y / verticesNum;
+  }
+
+  for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+    sectorEvents.emplace_back(event.getEventId());
+
+    for (int iVertex { 0 }; iVertex < verticesNum; ++iVertex) {
+
+      const float3& primaryVertex { event.getPrimaryVertex(iVertex) };
+      sectorEvents.back().addPrimaryVertex(primaryVertex.x, primaryVertex.y, primaryVertex.z);
+    }
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    for (const Cluster& cluster : event.getLayer(iLayer).getClusters()) {
+
+      const float phiCoordinate { MathUtils::calculatePhiCoordinate(cluster.xCoordinate - transverseOrigin.x,
+          cluster.yCoordinate - transverseOrigin.y) };
+      const int clusterSector { std::min(static_cast<int>(phiCoordinate / sectorPhiWidth), sectorsNum - 1) };
+
+      if (cluster.clusterId >= static_cast<int>(clustersSectors.size())) {
+
+        clustersSectors.resize(cluster.clusterId + 1, Constants::ITS::UnusedIndex);
+      }
+
+      clustersSectors[cluster.clusterId] = clusterSector;
+
+      for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+        if (isInPhiSector(phiCoordinate, clusterSector, iSector, sectorPhiWidth,
+            decompositionParameters.haloPhiWidth)) {
+
+          sectorEvents[iSector].pushClusterToLayer(iLayer, cluster.clusterId, cluster.xCoordinate,
+              cluster.yCoordinate, cluster.zCoordinate, cluster.alphaAngle, event.getMonteCarloId(cluster.clusterId));
+        }
+      }
+    }
+  }
+}
+
+void TrackingUtils::splitVertexChunks(const Event& event, const int vertexIndex,
+    const DecompositionParameters& decompositionParameters, std::vector<Event>& chunkEvents,
+    std::vector<int>& clustersChunks)
+{
+  /// The sectors are cut in the azimuth around the vertex and the slices bounds are the tan(lambda) quantiles of all
+  /// the clusters seen from it, so that the slices hold about as many clusters wherever the vertex lies in z
+  const int sectorsNum { decompositionParameters.sectorsNum };
+  const int slicesNum { decompositionParameters.slicesNum };
+  const float sectorPhiWidth { Constants::Math::TwoPi / sectorsNum };
+  const float haloTanLambdaWidth { decompositionParameters.haloTanLambdaWidth };
+  const float3& primaryVertex { event.getPrimaryVertex(vertexIndex) };
+  std::array<std::vector<float>, Constants::ITS::LayersNumber> phiCoordinates;
+  std::array<std::vector<float>, Constants::ITS::LayersNumber> tanLambdas;
+  std::vector<float> sortedTanLambdas { };
+  std::vector<float> slicesBounds(slicesNum + 1, std::numeric_limits<float>::max());
+
+  chunkEvents.clear();
+  clustersChunks.clear();
+
+  for (int iChunk { 0 }; iChunk < sectorsNum * slicesNum; ++iChunk) {
+
+    chunkEvents.emplace_back(event.getEventId());
+    chunkEvents.back().addPrimaryVertex(primaryVertex.x, primaryVertex.y, primaryVertex.z);
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    for (const Cluster& cluster : event.getLayer(iLayer).getClusters()) {
+
+      const float xCoordinate { cluster.xCoordinate - primaryVertex.x };
+      const float yCoordinate { cluster.yCoordinate - primaryVertex.y };
+      const float rCoordinate { std::sqrt(xCoordinate * xCoordinate + yCoordinate * yCoordinate) };
+
+      phiCoordinates[iLayer].push_back(MathUtils::calculatePhiCoordinate(xCoordinate, yCoordinate));
+      tanLambdas[iLayer].push_back((cluster.zCoordinate - primaryVertex.z) / rCoordinate);
+    }
+
+    sortedTanLambdas.insert(sortedTanLambdas.end(), tanLambdas[iLayer].begin(), tanLambdas[iLayer].end());
+  }
+
+  std::sort(sortedTanLambdas.begin(), sortedTanLambdas.end());
+  slicesBounds.front() = -std::numeric_limits<float>::max();
+
+  for (int iSlice { 1 }; iSlice < slicesNum && !sortedTanLambdas.empty(); ++iSlice) {
+
+    slicesBounds[iSlice] = sortedTanLambdas[iSlice * sortedTanLambdas.size() / slicesNum];
+  }
+
+  for (int iLayer { 0 }; iLayer < Constants::ITS::LayersNumber; ++iLayer) {
+
+    const std::vector<Cluster>& layerClusters { event.getLayer(iLayer).getClusters() };
+    const int clustersNum { static_cast<int>(layerClusters.size()) };
+
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+      const Cluster& cluster { layerClusters[iCluster] };
+      const float phiCoordinate { phiCoordinates[iLayer][iCluster] };
+      const float tanLambda { tanLambdas[iLayer][iCluster] };
+      const int clusterSector { std::min(static_cast<int>(phiCoordinate / sectorPhiWidth), sectorsNum - 1) };
+      const int clusterSlice { static_cast<int>(std::upper_bound(slicesBounds.begin() + 1, slicesBounds.end() - 1,
+          tanLambda) - slicesBounds.begin()) - 1 };
+
+      if (cluster.clusterId >= static_cast<int>(clustersChunks.size())) {
+
+        clustersChunks.resize(cluster.clusterId + 1, Constants::ITS::UnusedIndex);
+      }
+
+      clustersChunks[cluster.clusterId] = clusterSector * slicesNum + clusterSlice;
+
+      for (int iSector { 0 }; iSector < sectorsNum; ++iSector) {
+
+        if (!isInPhiSector(phiCoordinate, clusterSector, iSector, sectorPhiWidth,
+            decompositionParameters.haloPhiWidth)) {
+
+          continue;
+        }
+
+        for (int iSlice { 0 }; iSlice < slicesNum; ++iSlice) {
+
+          if (iSlice == clusterSlice || (tanLambda >= slicesBounds[iSlice] - haloTanLambdaWidth
+              && tanLambda < slicesBounds[iSlice + 1] + haloTanLambdaWidth)) {
+
+            chunkEvents[iSector * slicesNum + iSlice].pushClusterToLayer(iLayer, cluster.clusterId,
+                cluster.xCoordinate, cluster.yCoordinate, cluster.zCoordinate, cluster.alphaAngle,
+                event.getMonteCarloId(cluster.clusterId));
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
 }
 }
 }
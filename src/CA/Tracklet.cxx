@@ -33,7 +33,7 @@ GPU_DEVICE Tracklet::Tracklet(const int firstClusterIndex, const int secondClust
     const Cluster& firstCluster, const Cluster& secondCluster)
     : firstClusterIndex { firstClusterIndex }, secondClusterIndex { secondClusterIndex }, tanLambda {
         (firstCluster.zCoordinate - secondCluster.zCoordinate) / (firstCluster.rCoordinate - secondCluster.rCoordinate) }, phiCoordinate {
-    MATH_ATAN2(firstCluster.yCoordinate - secondCluster.yCoordinate,
+    MathUtils::fastAtan2(firstCluster.yCoordinate - secondCluster.yCoordinate,
         firstCluster.xCoordinate - secondCluster.xCoordinate) }
 {
   // Nothing to do
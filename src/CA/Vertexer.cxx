@@ -0,0 +1,331 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file Vertexer.cxx
+/// \brief
+///
+
+#include "ITSReconstruction/CA/Vertexer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/MathUtils.h"
+
+namespace o2
+{
+namespace ITS
+{
+namespace CA
+{
+
+namespace {
+/// Returns the index ranges [x, y) and [z, w) of the phi sorted coordinates within phiCut from phiCoordinate
+int4 getPhiRanges(const std::vector<float>& phiCoordinates, const float phiCoordinate, const float phiCut)
+{
+  const float minPhi { phiCoordinate - phiCut };
+  const float maxPhi { phiCoordinate + phiCut };
+  const int lastIndex { static_cast<int>(phiCoordinates.size()) };
+  auto getLowerIndex = [&phiCoordinates](const float phi) {
+    return static_cast<int>(std::lower_bound(phiCoordinates.begin(), phiCoordinates.end(), phi)
+        - phiCoordinates.begin());
+  };
+
+  if (minPhi < 0.f) {
+
+    return int4 { getLowerIndex(minPhi + Constants::Math::TwoPi), lastIndex, 0, getLowerIndex(maxPhi) };
+  }
+
+  if (maxPhi > Constants::Math::TwoPi) {
+
+    return int4 { getLowerIndex(minPhi), lastIndex, 0, getLowerIndex(maxPhi - Constants::Math::TwoPi) };
+  }
+
+  return int4 { getLowerIndex(minPhi), getLowerIndex(maxPhi), 0, 0 };
+}
+}
+
+constexpr int Vertexer::LayersNumber;
+
+Vertexer::Vertexer()
+{
+  // Nothing to do
+}
+
+Vertexer::Vertexer(const VertexingParameters& vertexingParameters)
+    : mVertexingParameters { vertexingParameters }
+{
+  // Nothing to do
+}
+
+std::vector<float3> Vertexer::findVertices(const Event& event)
+{
+  std::vector<float3> vertices { };
+
+  initializeLayers(event);
+
+  const int firstLayerClustersNum { static_cast<int>(mPhiCoordinates[0].size()) };
+
+  if (firstLayerClustersNum == 0 || mPhiCoordinates[1].empty() || mPhiCoordinates[2].empty()) {
+
+    return vertices;
+  }
+
+  const int threadsNum { std::max(1, std::min(mVertexingParameters.threadsNum, firstLayerClustersNum)) };
+  std::vector<std::vector<float>> threadsTrackletsZCoordinates(threadsNum - 1);
+  std::vector<std::future<void>> threadsTasks { };
+
+  for (int iThread { 1 }; iThread < threadsNum; ++iThread) {
+
+    const int firstClusterIndex { (iThread * firstLayerClustersNum) / threadsNum };
+    const int lastClusterIndex { ((iThread + 1) * firstLayerClustersNum) / threadsNum };
+    std::vector<float>& trackletsZCoordinates { threadsTrackletsZCoordinates[iThread - 1] };
+
+    threadsTasks.emplace_back(std::async(std::launch::async,
+        [this, firstClusterIndex, lastClusterIndex, &trackletsZCoordinates]() {
+          findLayerTracklets(firstClusterIndex, lastClusterIndex, trackletsZCoordinates);
+        }));
+  }
+
+  mTrackletsZCoordinates.clear();
+  findLayerTracklets(0, firstLayerClustersNum / threadsNum, mTrackletsZCoordinates);
+
+  for (int iThread { 1 }; iThread < threadsNum; ++iThread) {
+
+    threadsTasks[iThread - 1].get();
+    mTrackletsZCoordinates.insert(mTrackletsZCoordinates.end(), threadsTrackletsZCoordinates[iThread - 1].begin(),
+        threadsTrackletsZCoordinates[iThread - 1].end());
+  }
+
+  std::sort(mTrackletsZCoordinates.begin(), mTrackletsZCoordinates.end());
+
+  const float zRange { mVertexingParameters.zRange };
+  const float binSize { mVertexingParameters.binSize };
+  const int binsNum { static_cast<int>(std::ceil(2.f * zRange / binSize)) };
+  auto getBinIndex = [zRange, binSize, binsNum](const float zCoordinate) {
+    return std::max(0, std::min(binsNum - 1, static_cast<int>((zCoordinate + zRange) / binSize)));
+  };
+
+  mHistogram.assign(binsNum, 0);
+
+  for (const float zCoordinate : mTrackletsZCoordinates) {
+
+    ++mHistogram[getBinIndex(zCoordinate)];
+  }
+
+  while (true) {
+
+    int peakBinIndex { 0 };
+    int peakEntries { 0 };
+
+    for (int iBin { 0 }; iBin < binsNum; ++iBin) {
+
+      const int binEntries { mHistogram[iBin] + (iBin > 0 ? mHistogram[iBin - 1] : 0)
+          + (iBin < binsNum - 1 ? mHistogram[iBin + 1] : 0) };
+
+      if (binEntries > peakEntries) {
+
+        peakBinIndex = iBin;
+        peakEntries = binEntries;
+      }
+    }
+
+    const float backgroundEntries { 3.f * mTrackletsZCoordinates.size() / binsNum };
+
+    if (peakEntries < mVertexingParameters.minTrackletsNum
+        || peakEntries < backgroundEntries + mVertexingParameters.minPeakSignificance * std::sqrt(backgroundEntries)) {
+
+      break;
+    }
+
+    /// The vertex is the mean of the tracklets around the peak, the window is centred again on the first mean
+    float vertexZCoordinate { -zRange + (peakBinIndex + 0.5f) * binSize };
+    auto firstTracklet = mTrackletsZCoordinates.begin();
+    auto lastTracklet = mTrackletsZCoordinates.begin();
+
+    for (int iPass { 0 }; iPass < 2; ++iPass) {
+
+      firstTracklet = std::lower_bound(mTrackletsZCoordinates.begin(), mTrackletsZCoordinates.end(),
+          vertexZCoordinate - mVertexingParameters.peakWidth);
+      lastTracklet = std::upper_bound(firstTracklet, mTrackletsZCoordinates.end(),
+          vertexZCoordinate + mVertexingParameters.peakWidth);
+
+      if (firstTracklet == lastTracklet) {
+
+        break;
+      }
+
+      vertexZCoordinate = std::accumulate(firstTracklet, lastTracklet, 0.f) / (lastTracklet - firstTracklet);
+    }
+
+    if (lastTracklet - firstTracklet < mVertexingParameters.minTrackletsNum) {
+
+      for (int iBin { std::max(0, peakBinIndex - 1) }; iBin <= std::min(binsNum - 1, peakBinIndex + 1); ++iBin) {
+
+        mHistogram[iBin] = 0;
+      }
+
+      continue;
+    }
+
+    firstTracklet = std::lower_bound(mTrackletsZCoordinates.begin(), mTrackletsZCoordinates.end(),
+        vertexZCoordinate - mVertexingParameters.exclusionWidth);
+    lastTracklet = std::upper_bound(firstTracklet, mTrackletsZCoordinates.end(),
+        vertexZCoordinate + mVertexingParameters.exclusionWidth);
+
+    for (auto iTracklet = firstTracklet; iTracklet != lastTracklet; ++iTracklet) {
+
+      --mHistogram[getBinIndex(*iTracklet)];
+    }
+
+    mTrackletsZCoordinates.erase(firstTracklet, lastTracklet);
+    vertices.emplace_back(float3 { mVertexingParameters.beamPosition.x, mVertexingParameters.beamPosition.y,
+        vertexZCoordinate });
+  }
+
+  return vertices;
+}
+
+void Vertexer::computeVertices(Event& event)
+{
+  const std::vector<float3> vertices { findVertices(event) };
+
+  for (const float3& vertex : vertices) {
+
+    event.addPrimaryVertex(vertex.x, vertex.y, vertex.z);
+  }
+}
+
+void Vertexer::initializeLayers(const Event& event)
+{
+  std::vector<float> xCoordinates { };
+  std::vector<float> yCoordinates { };
+  std::vector<float> phiCoordinates { };
+  std::vector<int> sortedIndexes { };
+
+  for (int iLayer { 0 }; iLayer < LayersNumber; ++iLayer) {
+
+    const Layer& currentLayer { event.getLayer(iLayer) };
+    const int clustersNum { currentLayer.getClustersSize() };
+
+    xCoordinates.resize(clustersNum);
+    yCoordinates.resize(clustersNum);
+    phiCoordinates.resize(clustersNum);
+    sortedIndexes.resize(clustersNum);
+
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+      xCoordinates[iCluster] = currentLayer.getCluster(iCluster).xCoordinate;
+      yCoordinates[iCluster] = currentLayer.getCluster(iCluster).yCoordinate;
+      sortedIndexes[iCluster] = iCluster;
+    }
+
+    MathUtils::calculatePhiCoordinates(xCoordinates.data(), yCoordinates.data(), mVertexingParameters.beamPosition.x,
+        mVertexingParameters.beamPosition.y, phiCoordinates.data(), clustersNum);
+
+    std::sort(sortedIndexes.begin(), sortedIndexes.end(), [&phiCoordinates](const int index1, const int index2) {
+      return phiCoordinates[index1] < phiCoordinates[index2];
+    });
+
+    mPhiCoordinates[iLayer].resize(clustersNum);
+    mRCoordinates[iLayer].resize(clustersNum);
+    mZCoordinates[iLayer].resize(clustersNum);
+
+    for (int iCluster { 0 }; iCluster < clustersNum; ++iCluster) {
+
+      const Cluster& currentCluster { currentLayer.getCluster(sortedIndexes[iCluster]) };
+      mPhiCoordinates[iLayer][iCluster] = phiCoordinates[sortedIndexes[iCluster]];
+      mRCoordinates[iLayer][iCluster] = MathUtils::calculateRCoordinate(
+          currentCluster.xCoordinate - mVertexingParameters.beamPosition.x,
+          currentCluster.yCoordinate - mVertexingParameters.beamPosition.y);
+      mZCoordinates[iLayer][iCluster] = currentCluster.zCoordinate;
+    }
+  }
+}
+
+void Vertexer::findLayerTracklets(const int firstClusterIndex, const int lastClusterIndex,
+    std::vector<float>& trackletsZCoordinates) const
+{
+  /// The z coordinates of the beam line crossing of the candidates of a cluster are computed in a separate loop over
+  /// contiguous arrays, so that the compiler can vectorise it
+  std::vector<float> candidatesZCoordinates { };
+
+  for (int iCluster { firstClusterIndex }; iCluster < lastClusterIndex; ++iCluster) {
+
+    const float firstRCoordinate { mRCoordinates[0][iCluster] };
+    const float firstZCoordinate { mZCoordinates[0][iCluster] };
+    const int4 secondLayerRanges { getPhiRanges(mPhiCoordinates[1], mPhiCoordinates[0][iCluster],
+        mVertexingParameters.phiCut) };
+    const std::array<int, 4> secondLayerRangesLimits { { secondLayerRanges.x, secondLayerRanges.y,
+        secondLayerRanges.z, secondLayerRanges.w } };
+
+    for (int iSecondRange { 0 }; iSecondRange < 4; iSecondRange += 2) {
+
+      const int firstCandidateIndex { secondLayerRangesLimits[iSecondRange] };
+      const int candidatesNum { secondLayerRangesLimits[iSecondRange + 1] - firstCandidateIndex };
+
+      if (candidatesNum <= 0) {
+
+        continue;
+      }
+
+      const float* secondRCoordinates { mRCoordinates[1].data() + firstCandidateIndex };
+      const float* secondZCoordinates { mZCoordinates[1].data() + firstCandidateIndex };
+      candidatesZCoordinates.resize(candidatesNum);
+
+      for (int iCandidate { 0 }; iCandidate < candidatesNum; ++iCandidate) {
+
+        candidatesZCoordinates[iCandidate] = firstZCoordinate
+            - firstRCoordinate * (secondZCoordinates[iCandidate] - firstZCoordinate)
+                / (secondRCoordinates[iCandidate] - firstRCoordinate);
+      }
+
+      for (int iCandidate { 0 }; iCandidate < candidatesNum; ++iCandidate) {
+
+        const float vertexZCoordinate { candidatesZCoordinates[iCandidate] };
+
+        if (std::abs(vertexZCoordinate) > mVertexingParameters.zRange) {
+
+          continue;
+        }
+
+        const float slope { (secondZCoordinates[iCandidate] - firstZCoordinate)
+            / (secondRCoordinates[iCandidate] - firstRCoordinate) };
+        const int4 thirdLayerRanges { getPhiRanges(mPhiCoordinates[2],
+            mPhiCoordinates[1][firstCandidateIndex + iCandidate], mVertexingParameters.phiCut) };
+        const std::array<int, 4> thirdLayerRangesLimits { { thirdLayerRanges.x, thirdLayerRanges.y,
+            thirdLayerRanges.z, thirdLayerRanges.w } };
+        bool hasThirdCluster { false };
+
+        for (int iThirdRange { 0 }; !hasThirdCluster && iThirdRange < 4; iThirdRange += 2) {
+
+          for (int iThirdCluster { thirdLayerRangesLimits[iThirdRange] };
+              !hasThirdCluster && iThirdCluster < thirdLayerRangesLimits[iThirdRange + 1]; ++iThirdCluster) {
+
+            hasThirdCluster = std::abs(firstZCoordinate + slope * (mRCoordinates[2][iThirdCluster] - firstRCoordinate)
+                - mZCoordinates[2][iThirdCluster]) < mVertexingParameters.zCut;
+          }
+        }
+
+        if (hasThirdCluster) {
+
+          trackletsZCoordinates.push_back(vertexZCoordinate);
+        }
+      }
+    }
+  }
+}
+
+}
+}
+}
@@ -466,6 +466,7 @@ void TrackerTraits<true>::computeLayerCells(CA::PrimaryVertexContext& primaryVer
 
       primaryVertexContext.getDeviceCellsLookupTable()[iLayer - 1].copyIntoVector(
           primaryVertexContext.getCellsLookupTable()[iLayer - 1], trackletsNum[iLayer - 1]);
+      primaryVertexContext.getCellsLookupTable()[iLayer - 1].push_back(cellsSize);
     }
 
     primaryVertexContext.getDeviceCells()[iLayer].copyIntoVector(primaryVertexContext.getCells()[iLayer], cellsSize);
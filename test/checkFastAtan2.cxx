@@ -0,0 +1,183 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file checkFastAtan2.cxx
+/// \brief Accuracy checks of MathUtils::fastAtan2, run by check_fast_atan2.sh
+///
+/// checkFastAtan2 bound: scans the plane and fails if the error against the double atan2 exceeds the documented bound,
+///   or if a phi coordinate on the x axis leaves [0, 2 pi)
+/// checkFastAtan2 roads <data file>: prints the cluster ids of the tracks found in every vertex, sorted, to be
+///   compared between the default and the ReferenceAtan2 builds
+///
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/IndexTableUtils.h"
+#include "ITSReconstruction/CA/IOUtils.h"
+#include "ITSReconstruction/CA/MathUtils.h"
+#include "ITSReconstruction/CA/Track.h"
+#include "ITSReconstruction/CA/Tracker.h"
+
+using namespace o2::ITS::CA;
+
+namespace
+{
+
+constexpr double MaxAbsoluteError { 3.2e-7 };
+
+double getAbsoluteError(const float yCoordinate, const float xCoordinate)
+{
+  return std::abs(MathUtils::fastAtan2(yCoordinate, xCoordinate) - std::atan2(static_cast<double>(yCoordinate),
+      static_cast<double>(xCoordinate)));
+}
+
+bool isValidPhiCoordinate(const float phiCoordinate)
+{
+  return phiCoordinate >= 0.f && phiCoordinate < Constants::Math::TwoPi
+      && IndexTableUtils::getPhiBinIndex(phiCoordinate) < Constants::IndexTable::PhiBins;
+}
+
+int checkBound()
+{
+  const int anglesNum { 1 << 22 };
+  double maxError { 0. };
+  float maxErrorYCoordinate { 0.f }, maxErrorXCoordinate { 0.f };
+
+  for (int iAngle { 0 }; iAngle <= anglesNum; ++iAngle) {
+
+    const double angle { -M_PI + 2. * M_PI * iAngle / anglesNum };
+
+    for (const double radius : { 1e-3, 1., 40., 1e4 }) {
+
+      const float yCoordinate { static_cast<float>(radius * std::sin(angle)) };
+      const float xCoordinate { static_cast<float>(radius * std::cos(angle)) };
+      const double error { getAbsoluteError(yCoordinate, xCoordinate) };
+
+      if (error > maxError) {
+
+        maxError = error;
+        maxErrorYCoordinate = yCoordinate;
+        maxErrorXCoordinate = xCoordinate;
+      }
+    }
+  }
+
+  std::mt19937 generator { 12345 };
+  std::uniform_real_distribution<float> coordinates { -50.f, 50.f };
+
+  for (int iPoint { 0 }; iPoint < anglesNum; ++iPoint) {
+
+    const float yCoordinate { coordinates(generator) };
+    const float xCoordinate { coordinates(generator) };
+    const double error { getAbsoluteError(yCoordinate, xCoordinate) };
+
+    if (error > maxError) {
+
+      maxError = error;
+      maxErrorYCoordinate = yCoordinate;
+      maxErrorXCoordinate = xCoordinate;
+    }
+  }
+
+  std::cout << "Maximum absolute error: " << maxError << " rad at (y, x) = (" << maxErrorYCoordinate << ", "
+      << maxErrorXCoordinate << ")" << std::endl;
+
+  int failuresNum { maxError > MaxAbsoluteError };
+
+  for (const float yCoordinate : { 0.f, -0.f }) {
+
+    for (const float xCoordinate : { 1.f, -1.f }) {
+
+      const float phiCoordinate { MathUtils::calculatePhiCoordinate(xCoordinate, yCoordinate) };
+      float batchPhiCoordinate { };
+      MathUtils::calculatePhiCoordinates(&xCoordinate, &yCoordinate, 0.f, 0.f, &batchPhiCoordinate, 1);
+
+      if (getAbsoluteError(yCoordinate, xCoordinate) > MaxAbsoluteError || !isValidPhiCoordinate(phiCoordinate)
+          || !isValidPhiCoordinate(batchPhiCoordinate)) {
+
+        std::cout << "Invalid angle at (y, x) = (" << yCoordinate << ", " << xCoordinate << "): atan2 "
+            << MathUtils::fastAtan2(yCoordinate, xCoordinate) << ", phi " << phiCoordinate << ", batch phi "
+            << batchPhiCoordinate << std::endl;
+        ++failuresNum;
+      }
+    }
+  }
+
+  return failuresNum == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int printRoads(const std::string& eventsFileName)
+{
+  std::vector<Event> events { IOUtils::loadEventData(eventsFileName) };
+  TrackingParameters trackingParameters { };
+  trackingParameters.tracksFitting = true;
+  Tracker<TRACKINGITSU_GPU_MODE> tracker { trackingParameters };
+
+  for (int iEvent { 0 }; iEvent < static_cast<int>(events.size()); ++iEvent) {
+
+    tracker.clustersToTracks(events[iEvent]);
+    const std::vector<std::vector<Track>>& tracks { tracker.getTracks() };
+
+    for (int iVertex { 0 }; iVertex < static_cast<int>(tracks.size()); ++iVertex) {
+
+      std::vector<std::array<int, Constants::ITS::LayersNumber>> clusterIds { };
+
+      for (const Track& track : tracks[iVertex]) {
+
+        clusterIds.push_back(track.clusterIds);
+      }
+
+      std::sort(clusterIds.begin(), clusterIds.end());
+
+      for (const std::array<int, Constants::ITS::LayersNumber>& trackClusterIds : clusterIds) {
+
+        std::cout << iEvent << "\t" << iVertex;
+
+        for (const int clusterId : trackClusterIds) {
+
+          std::cout << "\t" << clusterId;
+        }
+
+        std::cout << std::endl;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  const std::string mode { argc > 1 ? argv[1] : "" };
+
+  if (mode == "bound") {
+
+    return checkBound();
+  }
+
+  if (mode == "roads" && argc > 2) {
+
+    return printRoads(argv[2]);
+  }
+
+  std::cerr << "Usage: " << argv[0] << " bound | roads <data file>" << std::endl;
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,137 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file checkMemoryBudget.cxx
+/// \brief Check of the memory budgeted chunked mode of the tracker, run by check_memory_budget.sh
+///
+/// checkMemoryBudget <data file> [budget ratio]: tracks every event with a memory budget of the given ratio (default
+///   0.5) of the footprint of its Constants::Memory::MaxPhiSectorsNum phi sectors, so that the phi sectors alone
+///   cannot fit it, and fails if the event throws or if its tracks differ from the ones found without budget
+///
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ITSReconstruction/CA/Configuration.h"
+#include "ITSReconstruction/CA/Constants.h"
+#include "ITSReconstruction/CA/Event.h"
+#include "ITSReconstruction/CA/IOUtils.h"
+#include "ITSReconstruction/CA/Track.h"
+#include "ITSReconstruction/CA/Tracker.h"
+#include "ITSReconstruction/CA/TrackingUtils.h"
+
+using namespace o2::ITS::CA;
+
+namespace
+{
+
+/// Largest memory retained by the tracking of a phi sector of the event, each one tracked by its own tracker
+std::size_t getPhiSectorsFootprint(const Event& event, const TrackingParameters& trackingParameters)
+{
+  DecompositionParameters decompositionParameters { };
+  std::vector<Event> sectorEvents { };
+  std::vector<int> clustersSectors { };
+  std::size_t footprint { 0 };
+  decompositionParameters.sectorsNum = Constants::Memory::MaxPhiSectorsNum;
+  TrackingUtils::splitPhiSectors(event, decompositionParameters, sectorEvents, clustersSectors);
+
+  for (const Event& sectorEvent : sectorEvents) {
+
+    Tracker<TRACKINGITSU_GPU_MODE> tracker { trackingParameters };
+    tracker.clustersToTracks(sectorEvent);
+    footprint = std::max(footprint, tracker.getRetainedMemorySize());
+  }
+
+  return footprint;
+}
+
+/// Cluster ids of the tracks found in every vertex, sorted
+std::vector<std::vector<std::array<int, Constants::ITS::LayersNumber>>> getTracksClusterIds(
+    const Tracker<TRACKINGITSU_GPU_MODE>& tracker)
+{
+  const std::vector<std::vector<Track>>& tracks { tracker.getTracks() };
+  std::vector<std::vector<std::array<int, Constants::ITS::LayersNumber>>> clusterIds(tracks.size());
+
+  for (int iVertex { 0 }; iVertex < static_cast<int>(tracks.size()); ++iVertex) {
+
+    for (const Track& track : tracks[iVertex]) {
+
+      clusterIds[iVertex].push_back(track.clusterIds);
+    }
+
+    std::sort(clusterIds[iVertex].begin(), clusterIds[iVertex].end());
+  }
+
+  return clusterIds;
+}
+
+int checkBudget(const std::string& eventsFileName, const float budgetRatio)
+{
+  std::vector<Event> events { IOUtils::loadEventData(eventsFileName) };
+  TrackingParameters trackingParameters { };
+  trackingParameters.tracksFitting = true;
+  Tracker<TRACKINGITSU_GPU_MODE> referenceTracker { trackingParameters };
+  Tracker<TRACKINGITSU_GPU_MODE> budgetedTracker { trackingParameters };
+  int failuresNum { 0 };
+
+  for (int iEvent { 0 }; iEvent < static_cast<int>(events.size()); ++iEvent) {
+
+    const std::size_t footprint { getPhiSectorsFootprint(events[iEvent], trackingParameters) };
+    MemoryParameters memoryParameters { };
+    memoryParameters.memoryBudget = static_cast<std::size_t>(budgetRatio * footprint);
+    budgetedTracker.setMemoryParameters(memoryParameters);
+
+    std::cout << "Event " << iEvent << ": phi sectors footprint " << footprint << " B, budget "
+        << memoryParameters.memoryBudget << " B" << std::endl;
+
+    referenceTracker.clustersToTracks(events[iEvent]);
+
+    try {
+
+      budgetedTracker.clustersToTracks(events[iEvent]);
+
+    } catch (const std::runtime_error& exception) {
+
+      std::cout << "Event " << iEvent << " failed: " << exception.what() << std::endl;
+      ++failuresNum;
+      continue;
+    }
+
+    const bool hasSameTracks { getTracksClusterIds(budgetedTracker) == getTracksClusterIds(referenceTracker) };
+
+    if (budgetedTracker.getRetainedMemorySize() > memoryParameters.memoryBudget || !hasSameTracks) {
+
+      std::cout << "Event " << iEvent << " failed: retained " << budgetedTracker.getRetainedMemorySize() << " B, "
+          << (hasSameTracks ? "same" : "different") << " tracks as without budget" << std::endl;
+      ++failuresNum;
+    }
+  }
+
+  return failuresNum == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) {
+
+    return checkBudget(argv[1], argc > 2 ? std::atof(argv[2]) : 0.5f);
+  }
+
+  std::cerr << "Usage: " << argv[0] << " <data file> [budget ratio]" << std::endl;
+
+  return EXIT_FAILURE;
+}
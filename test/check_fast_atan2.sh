@@ -0,0 +1,20 @@
+# Accuracy check of MathUtils::fastAtan2: the documented error bound on a scan of the plane, then the tracks found
+# on a sample with the default build against the ones found with std::atan2 (ReferenceAtan2 build type).
+# Usage: check_fast_atan2.sh [data file] [work directory], the data file defaults to data.txt as in build.sh
+set -ex
+TRACKINGITSU_SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+DATA_FILE=$(realpath "${1:-data.txt}")
+WORK_DIR=$(realpath "${2:-fast_atan2_check}")
+
+for BUILD_TYPE in None ReferenceAtan2; do
+    mkdir -p ${WORK_DIR}/${BUILD_TYPE}
+    cd ${WORK_DIR}/${BUILD_TYPE}
+    cmake -DCMAKE_BUILD_TYPE=${BUILD_TYPE} ${TRACKINGITSU_SRC_DIR}
+    make
+    g++ -std=c++11 -O3 -Wall -I${TRACKINGITSU_SRC_DIR}/include ${TRACKINGITSU_SRC_DIR}/test/checkFastAtan2.cxx \
+        src/libsrc.a -o checkFastAtan2 -lpthread
+    ./checkFastAtan2 roads ${DATA_FILE} > roads.txt
+done
+
+${WORK_DIR}/None/checkFastAtan2 bound
+diff ${WORK_DIR}/None/roads.txt ${WORK_DIR}/ReferenceAtan2/roads.txt
@@ -0,0 +1,16 @@
+# Check of the memory budgeted chunked mode: every event of a sample is tracked with a budget below the footprint of
+# its phi sectors, so that it is also split in tan(lambda) slices, and must give the same tracks as without budget.
+# Usage: check_memory_budget.sh [data file] [work directory], the data file defaults to data.txt as in build.sh
+set -ex
+TRACKINGITSU_SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+DATA_FILE=$(realpath "${1:-data.txt}")
+WORK_DIR=$(realpath "${2:-memory_budget_check}")
+
+mkdir -p ${WORK_DIR}
+cd ${WORK_DIR}
+cmake ${TRACKINGITSU_SRC_DIR}
+make
+g++ -std=c++11 -O3 -Wall -I${TRACKINGITSU_SRC_DIR}/include ${TRACKINGITSU_SRC_DIR}/test/checkMemoryBudget.cxx \
+    src/libsrc.a -o checkMemoryBudget -lpthread
+
+./checkMemoryBudget ${DATA_FILE}